@@ -1,10 +1,11 @@
 #include "nanobench.h"
 #include "tokoeka/solver.h"
 #include <cassert>
+#include <vector>
 
 using namespace tokoeka;
 
-static void build_solver(solver_t* S, symbol_t width, symbol_t height)
+static void build_solver(solver_t* S, symbol_t width, symbol_t height, bool batch = false)
 {
     // Create custom strength
     num_t mmedium = STRENGTH_MEDIUM * 1.25;
@@ -175,31 +176,96 @@ static void build_solver(solver_t* S, symbol_t width, symbol_t height)
     };
 
     
-    for (const auto& constraint : constraints) {
-        symbol_t symbols[5];   
-        num_t multipiers[5];    
+    const size_t constraint_count = sizeof(constraints) / sizeof(constraints[0]);
+    symbol_t symbols[constraint_count][5];   
+    num_t multipiers[constraint_count][5];    
+    constraint_desc_t descs[constraint_count];
+
+    for (size_t i = 0; i < constraint_count; ++i) {
+        const auto& constraint = constraints[i];
 
         int term_count = 0;
         for (auto* p = constraint.term; p->var; ++p, ++term_count) {
-            symbols[term_count] = p->var;
-            multipiers[term_count] = p->mul ? p->mul : 1;
+            symbols[i][term_count] = p->var;
+            multipiers[i][term_count] = p->mul ? p->mul : 1;
         }        
 
         constraint_desc_t desc = {};
         desc.strength = constraint.strength;
         desc.term_count = term_count;
-        desc.symbols = symbols;
-        desc.multipliers = multipiers;
+        desc.symbols = symbols[i];
+        desc.multipliers = multipiers[i];
         desc.relation = constraint.relation;
         desc.constant = -constraint.constant;
-        
+        descs[i] = desc;
+    }
+
+    if (batch) {
+        constraint_handle_t cons[constraint_count];
+        result_e r = add_constraints(S, constraint_count, descs, cons, nullptr);
+
+        assert(r == result_e::OK);
+        (void)r;
+        return;
+    }
+
+    for (const auto& desc : descs) {
         constraint_handle_t c;
         result_e r = add_constraint(S, &desc, &c);
 
         assert(r == result_e::OK);
+        (void)r;
     }
 }
 
+/**
+ * Row of items with min and max widths preferring the same width with distinct strengths, 
+ * so total width changes clamp items one by one and move the solver to another basis
+ */
+static symbol_t build_row_solver(solver_t* S, uint32_t item_count)
+{
+    symbol_t total = create_variable(S);
+    std::vector<symbol_t> sum_symbols = {total};
+    std::vector<num_t> sum_multipliers = {-1.0};
+
+    for (uint32_t i = 0; i < item_count; ++i) {
+        symbol_t item_width = create_variable(S);
+        sum_symbols.push_back(item_width);
+        sum_multipliers.push_back(1.0);
+
+        num_t one = 1.0;
+        constraint_desc_t desc = {};
+        desc.term_count = 1;
+        desc.symbols = &item_width;
+        desc.multipliers = &one;
+
+        constraint_handle_t c;
+        desc.strength = STRENGTH_REQUIRED;
+        desc.relation = relation_e::GREATEQUAL;
+        desc.constant = 20.0;
+        add_constraint(S, &desc, &c);
+        desc.relation = relation_e::LESSEQUAL;
+        desc.constant = 200.0;
+        add_constraint(S, &desc, &c);
+        desc.strength = STRENGTH_WEAK * (i + 1);
+        desc.relation = relation_e::EQUAL;
+        desc.constant = 100.0;
+        add_constraint(S, &desc, &c);
+    }
+
+    constraint_desc_t desc = {};
+    desc.strength = STRENGTH_REQUIRED;
+    desc.term_count = sum_symbols.size();
+    desc.symbols = sum_symbols.data();
+    desc.multipliers = sum_multipliers.data();
+    desc.relation = relation_e::EQUAL;
+    constraint_handle_t c;
+    add_constraint(S, &desc, &c);
+
+    enable_edit(S, total, STRENGTH_STRONG);
+    return total;
+}
+
 int main()
 {
     ankerl::nanobench::Bench().minEpochIterations(10).run("building solver", [&] {
@@ -212,6 +278,16 @@ int main()
         destroy_solver(S);
     });
 
+    ankerl::nanobench::Bench().minEpochIterations(10).run("building solver (batch)", [&] {
+        solver_desc_t solver_desc = {};
+        solver_t *S = create_solver(&solver_desc);
+        symbol_t width = create_variable(S);
+        symbol_t height = create_variable(S);
+        build_solver(S, width, height, true);
+        ankerl::nanobench::doNotOptimizeAway(S);
+        destroy_solver(S);
+    });
+
     struct Size
     {
         int width;
@@ -233,6 +309,21 @@ int main()
     symbol_t heightVar = create_variable(S);
     build_solver(S, widthVar, heightVar);
 
+    solver_t *snapshot = clone_solver(S);
+    ankerl::nanobench::Bench().minEpochIterations(100).run("restoring solver", [&] {
+        restore_solver(S, snapshot);
+        ankerl::nanobench::doNotOptimizeAway(S);
+    });
+    destroy_solver(snapshot);
+
+    std::vector<uint8_t> image(save_solver(S, nullptr, 0));
+    save_solver(S, image.data(), image.size());
+    ankerl::nanobench::Bench().minEpochIterations(100).run("loading solver", [&] {
+        solver_t *L = load_solver(&solver_desc, image.data(), image.size());
+        ankerl::nanobench::doNotOptimizeAway(L);
+        destroy_solver(L);
+    });
+
     for (const Size& size : sizes)
     {
         num_t width = size.width;
@@ -245,10 +336,66 @@ int main()
         });
     }
 
+    // every suggest changes both values
+    size_t size_index = 0;
+    ankerl::nanobench::Bench().minEpochIterations(100).run("suggest value cycling sizes", [&] {
+        const Size& size = sizes[size_index++ % (sizeof(sizes) / sizeof(sizes[0]))];
+        symbol_t vars[] = {widthVar, heightVar};
+        num_t values[] = {(num_t)size.width, (num_t)size.height};
+        suggest(S, 2, vars, values);
+    });
+
     disable_edit(S, widthVar);
     disable_edit(S, heightVar);
 
     destroy_solver(S);
 
+    // clamping sizes pivot to another basis on every suggest, the cache takes visited ones instead
+    const uint32_t item_count = 32;
+    const num_t row_widths[] = { 1000.0, 3200.0, 5000.0, 3200.0 };
+    for (uint32_t cache_capacity : {0u, 4u}) {
+        solver_t *R = create_solver(&solver_desc);
+        symbol_t total = build_row_solver(R, item_count);
+        set_basis_cache(R, cache_capacity);
+
+        size_t width_index = 0;
+        std::string name = cache_capacity ? "suggest value cycling clamped row (basis cache)" : "suggest value cycling clamped row";
+        ankerl::nanobench::Bench().minEpochIterations(100).run(name, [&] {
+            suggest(R, total, row_widths[width_index++ % (sizeof(row_widths) / sizeof(row_widths[0]))]);
+        });
+
+        destroy_solver(R);
+    }
+
+    // loosely connected windows share the solver, a suggest in one of them is expected to cost the same for any window count
+    for (uint32_t window_count : {1u, 16u, 64u}) {
+        solver_t *W = create_solver(&solver_desc);
+        symbol_t window_width = 0, window_height = 0;
+        for (uint32_t i = 0; i < window_count; ++i) {
+            window_width = create_variable(W);
+            window_height = create_variable(W);
+            build_solver(W, window_width, window_height);
+        }
+        symbol_t row_total = 0;
+        for (uint32_t i = 0; i < window_count; ++i) {
+            row_total = build_row_solver(W, item_count);
+        }
+
+        size_t size_index = 0;
+        ankerl::nanobench::Bench().minEpochIterations(100).run("suggest value cycling sizes, 1 of " + std::to_string(window_count) + " windows", [&] {
+            const Size& size = sizes[size_index++ % (sizeof(sizes) / sizeof(sizes[0]))];
+            symbol_t vars[] = {window_width, window_height};
+            num_t values[] = {(num_t)size.width, (num_t)size.height};
+            suggest(W, 2, vars, values);
+        });
+
+        size_t width_index = 0;
+        ankerl::nanobench::Bench().minEpochIterations(100).run("suggest value cycling clamped row, 1 of " + std::to_string(window_count) + " rows", [&] {
+            suggest(W, row_total, row_widths[width_index++ % (sizeof(row_widths) / sizeof(row_widths[0]))]);
+        });
+
+        destroy_solver(W);
+    }
+
     return 0;
 }
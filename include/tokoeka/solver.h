@@ -9,7 +9,8 @@ enum class result_e : uint8_t {
     OK,
     FAILED,
     UNSATISFIED,
-    UNBOUND
+    UNBOUND,
+    PARTIAL
 };
 
 enum class relation_e : uint8_t {
@@ -62,6 +63,42 @@ solver_t* create_solver(const solver_desc_t* desc);
  */
 void destroy_solver(solver_t* solver);
 
+/**
+ * Make a copy of the solver with the same allocator, every buffer is copied as a whole, 
+ * variable and constraint handles are the same for both solvers
+ * @param solver solver
+ * @return solver copy, destroyed by destroy_solver
+ */
+solver_t* clone_solver(const solver_t* solver);
+
+/**
+ * Restore solver state out of the snapshot solver (made by clone_solver usually), 
+ * solver buffers are reused if they are large enough
+ * @param solver solver
+ * @param snapshot solver state to copy
+ */
+void restore_solver(solver_t* solver, const solver_t* snapshot);
+
+/**
+ * Write binary image of the solver state, the image is position independent, 
+ * but it can be loaded by the same library build only (record layouts and index policy are checked)
+ * @param solver solver
+ * @param buffer image buffer, nothing is written if the image doesn't fit
+ * @param capacity buffer byte size
+ * @return image byte size
+ */
+size_t save_solver(const solver_t* solver, void* buffer, size_t capacity);
+
+/**
+ * Allocate solver out of the image written by save_solver, 
+ * the image checksum, layout and sizes are validated before any allocation and record indices after loading
+ * @param desc solver creation info, page size is not used as buffer sizes come from the image
+ * @param image image data, no alignment is required
+ * @param size image byte size
+ * @return solver instance pointer or nullptr if the image is not valid
+ */
+solver_t* load_solver(const solver_desc_t* desc, const void* image, size_t size);
+
 /**
  * Add variable to solver
  * @param solver solver
@@ -69,6 +106,14 @@ void destroy_solver(solver_t* solver);
  */
 symbol_t create_variable(solver_t* solver);
 
+/**
+ * Add count variables with consecutive handles, freed handles are not reused
+ * @param solver solver
+ * @param count number of variables
+ * @return handle of the first variable, the rest follow it in order; 0 if count is 0 or out of handles
+ */
+symbol_t create_variables(solver_t* solver, uint32_t count);
+
 /**
  * Remove variable from solver, expects variable is not used(poor design?)
  * @param solver solver
@@ -77,6 +122,15 @@ symbol_t create_variable(solver_t* solver);
  */
 void delete_variable(solver_t* solver, symbol_t var);
 
+/**
+ * Remove variables from solver along with every constraint using them,
+ * objective is optimized once after all removals
+ * @param solver solver
+ * @param count number of variables
+ * @param vars variables to remove, 0 handles are skipped, repeated handles are removed once
+ */
+void delete_variables(solver_t* solver, uint32_t count, const symbol_t* vars);
+
 /**
  * Retrive calculated variable value
  * @param solver solver
@@ -85,6 +139,31 @@ void delete_variable(solver_t* solver, symbol_t var);
  */
 num_t value(solver_t* solver, symbol_t var);
 
+/**
+ * Retrive calculated values of consecutive symbols, internal symbols within the range are read as well
+ * @param solver solver
+ * @param first first symbol
+ * @param count number of symbols to read
+ * @param[out] out_values values of symbols [first, first + count)
+ */
+void values(solver_t* solver, symbol_t first, uint32_t count, num_t* out_values);
+
+/**
+ * Retrieve variables which values were changed since the last retrieval or clear_changed_variables call,
+ * retrieved variables are removed from tracking, call until less than capacity variables are returned to get all of them
+ * @param solver solver
+ * @param[out] out_vars changed variables
+ * @param capacity max number of variables to write into out_vars
+ * @return number of variables written
+ */
+uint32_t pop_changed_variables(solver_t* solver, symbol_t* out_vars, uint32_t capacity);
+
+/**
+ * Forget tracked variable value changes
+ * @param solver solver
+ */
+void clear_changed_variables(solver_t* solver);
+
 /**
  * Represents constraint declaration, defined in the next form:
  * s1 * a1 + s2 * a2 + ... + sn * an <=|==|>= c
@@ -107,6 +186,18 @@ struct constraint_desc_t {
  */
 result_e add_constraint(solver_t* solver, const constraint_desc_t* desc, constraint_handle_t* out_cons);
 
+/**
+ * Add multiple constraints to solver with a single optimization pass
+ * @param solver solver
+ * @param count number of constraints
+ * @param descs constraint descriptions
+ * @param[out] out_cons constraint handles, 0 for constraints failed to add
+ * @param[out] out_results per constraint operation results, optional
+ * @return OK if all constraints are added, first failed constraint result otherwise
+ */
+result_e add_constraints(solver_t* solver, uint32_t count, const constraint_desc_t* descs, 
+                         constraint_handle_t* out_cons, result_e* out_results);
+
 /**
  * Remove constraint out of solver
  * @param solver solver
@@ -114,6 +205,14 @@ result_e add_constraint(solver_t* solver, const constraint_desc_t* desc, constra
  */
 void remove_constraint(solver_t* solver, constraint_handle_t cons);
 
+/**
+ * Remove a set of constraints out of solver, objective is optimized once after all removals
+ * @param solver solver
+ * @param count number of constraint handles
+ * @param cons constraint handles, null handles are skipped
+ */
+void remove_constraints(solver_t* solver, uint32_t count, const constraint_handle_t* cons);
+
 /**
  * Make variable editable
  * @param solver solver
@@ -155,4 +254,114 @@ void suggest(solver_t *solver, uint16_t count, const symbol_t* vars, const num_t
  */
 void suggest(solver_t *solver, symbol_t var, num_t value);
 
+/**
+ * Provide desired variable values doing at most max_pivots dual simplex pivots, 
+ * unresolved rows are kept for continue_solve (values are readable, but not solved yet), 
+ * any other solver change finishes the solve first
+ * @param solver solver
+ * @param count number of modified variables
+ * @param vars editable symbols
+ * @param values desired values
+ * @param max_pivots pivot budget
+ * @return PARTIAL if the budget ran out, OK if solved
+ */
+result_e suggest(solver_t *solver, uint16_t count, const symbol_t* vars, const num_t* values, uint32_t max_pivots);
+
+/**
+ * Resume the solve left by a budgeted suggest
+ * @param solver solver
+ * @param max_pivots pivot budget
+ * @return PARTIAL if the budget ran out again, OK if solved (or nothing was left)
+ */
+result_e continue_solve(solver_t *solver, uint32_t max_pivots);
+
+/**
+ * Keep up to capacity solved bases visited by suggest (each is a whole solver copy) keyed by edit ranges, 
+ * suggest of values within a kept basis range takes it instead of pivoting back to it 
+ * (the solution is the same unless there are several optimal ones). 
+ * Any solver change other than suggest drops kept bases, the cache is not copied by clone_solver
+ * @param solver solver
+ * @param capacity max number of kept bases, 0 disables the cache (default)
+ */
+void set_basis_cache(solver_t *solver, uint32_t capacity);
+
+/**
+ * Range of suggested values keeping the current basis feasible (constant changes keep it optimal), 
+ * variable values are affine in the suggested value within the range, see edit_slope
+ * @param solver solver
+ * @param var editable symbol
+ * @param out_min lowest suggested value of the range, lowest num_t if unbounded
+ * @param out_max highest suggested value of the range, max num_t if unbounded
+ * @return FAILED if variable is not editable
+ */
+result_e edit_range(solver_t *solver, symbol_t var, num_t* out_min, num_t* out_max);
+
+/**
+ * Variable value change per unit of suggested value change of the edit variable within its edit range, 
+ * so value(var) + slope * (suggested - current suggested value) is the value after suggest
+ * @param solver solver
+ * @param edit_var editable symbol
+ * @param var variable
+ * @return value change rate, 0 if edit_var is not editable
+ */
+num_t edit_slope(solver_t *solver, symbol_t edit_var, symbol_t var);
+
+/**
+ * Change constants of constraints in place, the tableau is updated by dual simplex
+ * @param solver solver
+ * @param count number of constraints, each constraint is expected at most once
+ * @param cons constraint handles, null handles are skipped
+ * @param constants new constants
+ * @return UNSATISFIED if required constraints conflict with new constants, all constants are kept unchanged then
+ */
+result_e set_constraint_constant(solver_t *solver, 
+        uint32_t count, const constraint_handle_t* cons, const num_t* constants);
+
+/**
+ * Change constant of single constraint in place
+ * @param solver solver
+ * @param cons constraint handle
+ * @param constant new constant
+ * @return UNSATISFIED if required constraints conflict with new constant, the constant is kept unchanged then
+ */
+result_e set_constraint_constant(solver_t *solver, constraint_handle_t cons, num_t constant);
+
+/**
+ * Change strength of non-required constraint in place, objective is reoptimized from the current basis
+ * @param solver solver
+ * @param cons constraint handle
+ * @param strength new strength
+ * @return FAILED if either current or new strength is required
+ */
+result_e set_constraint_strength(solver_t *solver, constraint_handle_t cons, num_t strength);
+
+/**
+ * Enable or disable constraints keeping them in solver, objective is optimized once for all changes.
+ * Disabled constraint has zero strength, required constraint row is removed and remade on enable
+ * @param solver solver
+ * @param count number of constraints
+ * @param cons constraint handles, null handles are skipped
+ * @param enabled new state
+ * @return first failed result if some required constraint can't be added back on enable, it stays disabled then
+ */
+result_e set_constraint_enabled(solver_t *solver, 
+        uint32_t count, const constraint_handle_t* cons, bool enabled);
+
+/**
+ * Enable or disable single constraint
+ * @param solver solver
+ * @param cons constraint handle
+ * @param enabled new state
+ * @return failed result if required constraint can't be added back on enable, it stays disabled then
+ */
+result_e set_constraint_enabled(solver_t *solver, constraint_handle_t cons, bool enabled);
+
+/**
+ * Check constraint state
+ * @param solver solver
+ * @param cons constraint handle
+ * @return false for disabled or null constraint
+ */
+bool is_constraint_enabled(solver_t *solver, constraint_handle_t cons);
+
 }
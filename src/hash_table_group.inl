@@ -0,0 +1,184 @@
+#pragma once
+
+#include <cassert>
+#include "hash_types.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define HASH_GROUP_SSE2
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/**
+ * Linear probing with a 1 byte control array (7 bit hash fingerprint or empty mark)
+ * scanned a group of slots per compare, full hashes are checked on fingerprint match only.
+ * Control array keeps HASH_GROUP_WIDTH - 1 extra bytes mirroring the head
+ * to allow unaligned group loads at any slot index.
+ */
+
+const uint8_t HASH_CONTROL_EMPTY = 0x80;
+
+#if defined(__AVX2__)
+
+const uint32_t HASH_GROUP_WIDTH = 32;
+
+static uint32_t hash_group_match(const uint8_t* group, uint8_t value) {
+    auto group_bytes = _mm256_loadu_si256((const __m256i*)group);
+    auto cmp = _mm256_cmpeq_epi8(group_bytes, _mm256_set1_epi8((char)value));
+    return (uint32_t)_mm256_movemask_epi8(cmp);
+}
+
+#elif defined(HASH_GROUP_SSE2)
+
+const uint32_t HASH_GROUP_WIDTH = 16;
+
+static uint32_t hash_group_match(const uint8_t* group, uint8_t value) {
+    auto group_bytes = _mm_loadu_si128((const __m128i*)group);
+    auto cmp = _mm_cmpeq_epi8(group_bytes, _mm_set1_epi8((char)value));
+    return (uint32_t)_mm_movemask_epi8(cmp);
+}
+
+#else
+
+const uint32_t HASH_GROUP_WIDTH = 8;
+
+static uint32_t hash_group_match(const uint8_t* group, uint8_t value) {
+    uint32_t mask = 0u;
+    for (uint32_t i = 0; i < HASH_GROUP_WIDTH; ++i) {
+        mask |= (uint32_t)(group[i] == value) << i;
+    }
+    return mask;
+}
+
+#endif
+
+static uint32_t hash_group_lowest_bit(uint32_t mask) {
+    assert(mask);
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (uint32_t)index;
+#else
+    return (uint32_t)__builtin_ctz(mask);
+#endif
+}
+
+static uint8_t hash_group_fingerprint(uint32_t key_hash) {
+    return (uint8_t)(key_hash >> 25);
+}
+
+static uint32_t hash_group_control_size(uint32_t element_count) {
+    return element_count + HASH_GROUP_WIDTH - 1;
+}
+
+static void hash_group_set_control(const hash_desc_t* desc, uint32_t index, uint8_t value) {
+    desc->control[index] = value;
+
+    // update mirrored tail
+    const uint32_t control_size = hash_group_control_size(desc->element_count);
+    for (uint32_t i = index + desc->element_count; i < control_size; i += desc->element_count) {
+        desc->control[i] = value;
+    }
+}
+
+static hash32_find_iter_t hash_group_probe(const hash_desc_t* desc, uint32_t key_hash,
+                                           uint32_t index, uint32_t counter) {
+    const uint32_t index_mask = desc->element_count - 1;
+    const uint8_t fingerprint = hash_group_fingerprint(key_hash);
+
+    hash32_find_iter_t res = {};
+
+    for (; counter < desc->element_count; counter += HASH_GROUP_WIDTH) {
+        const uint8_t* group = desc->control + index;
+
+        // probe sequence ends at the first empty slot
+        uint32_t empty_mask = hash_group_match(group, HASH_CONTROL_EMPTY);
+        uint32_t probe_mask = empty_mask ? (empty_mask & (0u - empty_mask)) - 1u : ~0u;
+
+        uint32_t match_mask = hash_group_match(group, fingerprint) & probe_mask;
+        for (; match_mask; match_mask &= match_mask - 1u) {
+            uint32_t offset = hash_group_lowest_bit(match_mask);
+            res.index = (index + offset) & index_mask;
+            res.hash = desc->hashes[res.index];
+            if (res.hash == key_hash) {
+                res.counter = counter + offset;
+                return res;
+            }
+        }
+
+        if (empty_mask) {
+            uint32_t offset = hash_group_lowest_bit(empty_mask);
+            res.index = (index + offset) & index_mask;
+            res.hash = 0u;
+            res.counter = counter + offset;
+            return res;
+        }
+
+        index = (index + HASH_GROUP_WIDTH) & index_mask;
+    }
+
+    res.index = ~0u;
+    res.hash = 0u;
+    return res;
+}
+
+static void hash_group_init(hash_desc_t* desc) {
+    assert(desc->control);
+
+    for (uint32_t i = 0; i < hash_group_control_size(desc->element_count); ++i) {
+        desc->control[i] = HASH_CONTROL_EMPTY;
+    }
+}
+
+static hash32_find_iter_t hash_group_find_index(const hash_desc_t* desc, uint32_t key_hash) {
+    assert(desc->hashes);
+    assert(desc->control);
+    assert(key_hash);
+
+    return hash_group_probe(desc, key_hash, key_hash & (desc->element_count - 1), 0u);
+}
+
+static void hash_group_insert(hash_desc_t* desc, uint32_t index, uint32_t key_hash) {
+    assert(!desc->hashes[index]);
+    assert(key_hash);
+
+    desc->hashes[index] = key_hash;
+    hash_group_set_control(desc, index, hash_group_fingerprint(key_hash));
+}
+
+static uint32_t hash_group_erase(const hash_values_protocol_t* ht_api,
+                    hash_desc_t* desc, uint32_t index) {
+    assert(desc->hashes);
+    assert(desc->control);
+    assert(desc->data);
+
+    uint32_t counter = 0;
+    for (uint32_t i = (index + 1) & (desc->element_count - 1); i != index; i = (i + 1) & (desc->element_count - 1)) {
+        if (!desc->hashes[i]) break;
+
+        auto i_index = desc->hashes[i] & (desc->element_count - 1);
+
+        if ( (i > index && (i_index <= index || i_index > i)) ||
+             (i < index && (i_index <= index && i_index > i))) {
+            // swap
+            desc->hashes[index] = desc->hashes[i];
+            hash_group_set_control(desc, index, desc->control[i]);
+            ht_api->move(desc->data, index, i);
+            index = i;
+        }
+
+        counter++;
+    }
+
+    // clear index
+    desc->hashes[index] = 0u;
+    hash_group_set_control(desc, index, HASH_CONTROL_EMPTY);
+    ht_api->reset(desc->data, index);
+
+    return counter;
+}
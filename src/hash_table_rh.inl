@@ -30,28 +30,6 @@ static hash32_find_iter_t hash_rh_find_index(const hash_desc_t* desc, uint32_t k
     return res;
 }
 
-static hash32_find_iter_t hash_rh_find_next(const hash_desc_t* desc, const hash32_find_iter_t* prev_iter) {
-    assert(desc->hashes);
-    assert(prev_iter->hash);
-
-    hash32_find_iter_t res = {};
-
-    res.index = (prev_iter->index + 1) & (desc->element_count - 1);
-    for (res.counter = prev_iter->counter + 1; res.counter < desc->element_count; ++res.counter) {
-        res.hash = desc->hashes[res.index];
-        if (!res.hash || res.hash == prev_iter->hash) {
-            return res;
-        }
-
-        if (distance(desc, res.hash, res.index) < res.counter) return res;
-
-        res.index = (res.index + 1) & (desc->element_count - 1);
-    }
-
-    res.index = ~0u;
-    return res;
-}
-
 static uint32_t hash_rh_insert_move(const hash_values_protocol_t* ht_api, 
                     hash_desc_t* desc, uint32_t index) {
     // find empty slot
@@ -15,6 +15,7 @@ struct hash_values_protocol_t {
 
 struct hash_desc_t {
     uint32_t* hashes;
+    uint8_t*  control; // group probing only, see hash_table_group.inl
     void*     data;
     uint32_t  element_count;
 };
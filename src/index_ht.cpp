@@ -1,5 +1,7 @@
 #include "index_ht.h"
 #include "hash_table.inl"
+#include "hash_table_rh.inl"
+#include "hash_table_group.inl"
 #include <cstring>
 #include <cassert>
 
@@ -19,81 +21,316 @@ static const hash_values_protocol_t s_term_ht_impl = {
     element_data_reset
 };
 
-void init(index_ht_t& self, uint32_t* hashes, uint32_t* indices, uint32_t size) {
-    self.hashes = hashes;
-    self.indices = indices;
-    self.size = size;
-    self.count = 0u;
+///////////////////////////////////////////////////////////////////////////////
+// Policies
+///////////////////////////////////////////////////////////////////////////////
+
+struct linear_probing_t {
+    static const uint32_t MAX_LOAD_NUMERATOR   = 1u;
+    static const uint32_t MAX_LOAD_DENOMINATOR = 2u;
+
+    static uint32_t control_size(uint32_t) { return 0u; }
+    static void init(hash_desc_t*) {}
+
+    static hash32_find_iter_t find_index(const hash_desc_t* desc, uint32_t key_hash) {
+        return hash_find_index(desc, key_hash);
+    }
+
+    static void insert(hash_desc_t* desc, uint32_t index, uint32_t key_hash) {
+        assert(!desc->hashes[index]);
+        desc->hashes[index] = key_hash;
+    }
+
+    static void erase(hash_desc_t* desc, uint32_t index) {
+        hash_erase(&s_term_ht_impl, desc, index);
+    }
+
+    static void clear(hash_desc_t* desc, uint32_t index) {
+        desc->hashes[index] = 0u;
+    }
+};
+
+struct robin_hood_t {
+    // bounded probe length allows higher load
+    static const uint32_t MAX_LOAD_NUMERATOR   = 3u;
+    static const uint32_t MAX_LOAD_DENOMINATOR = 4u;
+
+    static uint32_t control_size(uint32_t) { return 0u; }
+    static void init(hash_desc_t*) {}
+
+    static hash32_find_iter_t find_index(const hash_desc_t* desc, uint32_t key_hash) {
+        return hash_rh_find_index(desc, key_hash);
+    }
+
+    static void insert(hash_desc_t* desc, uint32_t index, uint32_t key_hash) {
+        // lookup stops at richer element, shift it and the rest of the cluster forward
+        hash_rh_insert_move(&s_term_ht_impl, desc, index);
+        desc->hashes[index] = key_hash;
+    }
+
+    static void erase(hash_desc_t* desc, uint32_t index) {
+        hash_rh_erase(&s_term_ht_impl, desc, index);
+    }
+
+    static void clear(hash_desc_t* desc, uint32_t index) {
+        desc->hashes[index] = 0u;
+    }
+};
+
+struct group_probing_t {
+    // fingerprint scan keeps probe sequences cheap at higher load
+    static const uint32_t MAX_LOAD_NUMERATOR   = 3u;
+    static const uint32_t MAX_LOAD_DENOMINATOR = 4u;
+
+    static uint32_t control_size(uint32_t size) { return hash_group_control_size(size); }
+    static void init(hash_desc_t* desc) { hash_group_init(desc); }
+
+    static hash32_find_iter_t find_index(const hash_desc_t* desc, uint32_t key_hash) {
+        return hash_group_find_index(desc, key_hash);
+    }
+
+    static void insert(hash_desc_t* desc, uint32_t index, uint32_t key_hash) {
+        hash_group_insert(desc, index, key_hash);
+    }
+
+    static void erase(hash_desc_t* desc, uint32_t index) {
+        hash_group_erase(&s_term_ht_impl, desc, index);
+    }
+
+    static void clear(hash_desc_t* desc, uint32_t index) {
+        desc->hashes[index] = 0u;
+        hash_group_set_control(desc, index, HASH_CONTROL_EMPTY);
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Table
+///////////////////////////////////////////////////////////////////////////////
+
+static hash_desc_t make_desc(const slots_t& slots) {
+    hash_desc_t ht_desc = {};
+    ht_desc.hashes = slots.hashes;
+    ht_desc.control = slots.control;
+    ht_desc.data = slots.indices;
+    ht_desc.element_count = slots.size;
+    return ht_desc;
+}
+
+template<typename P>
+static void init_slots(slots_t& slots, void* buffer, uint32_t size) {
+    assert(!(size & (size - 1)) && "expect power of 2 size");
+
+    slots.hashes = (uint32_t*)buffer;
+    slots.indices = slots.hashes + size;
+    slots.control = P::control_size(size) ? (uint8_t*)(slots.indices + size) : nullptr;
+    slots.size = size;
+    slots.count = 0u;
 
     auto buffer_byte_size = sizeof(uint32_t) * size;
-    memset(self.hashes, 0, buffer_byte_size);
+    memset(slots.hashes, 0, buffer_byte_size);
+
+    auto ht_desc = make_desc(slots);
+    P::init(&ht_desc);
+}
+
+template<typename P>
+static void insert_slot(slots_t& slots, uint32_t slot_index, uint32_t key_hash, uint32_t value) {
+    hash_desc_t ht_desc = make_desc(slots);
+    P::insert(&ht_desc, slot_index, key_hash);
+    slots.indices[slot_index] = value;
+
+    ++slots.count;
 }
 
-uint32_t erase(index_ht_t& self, uint32_t ht_index) {
-    assert(self.count);
+template<typename P>
+size_t buffer_size(uint32_t size) {
+    return sizeof(uint32_t) * size * 2 + P::control_size(size);
+}
 
-    uint32_t value = self.indices[ht_index];
+template<typename P>
+void init(table_t<P>& self, void* buffer, uint32_t size) {
+    self = {};
+    init_slots<P>(self.slots, buffer, size);
+}
 
-    hash_desc_t ht_desc = {};
-    ht_desc.hashes = self.hashes;
-    ht_desc.data = self.indices;
-    ht_desc.element_count = self.size;
-    auto erase_count = hash_erase(&s_term_ht_impl, &ht_desc, ht_index);
+template<typename P>
+static void rebase_slots(slots_t& slots, void* buffer) {
+    slots.hashes = (uint32_t*)buffer;
+    slots.indices = slots.hashes + slots.size;
+    slots.control = P::control_size(slots.size) ? (uint8_t*)(slots.indices + slots.size) : nullptr;
+}
 
-    --self.count;
+template<typename P>
+void rebase(table_t<P>& self, void* buffer, void* prev_buffer) {
+    rebase_slots<P>(self.slots, buffer);
+    if (prev_buffer) {
+        rebase_slots<P>(self.prev_slots, prev_buffer);
+    } else {
+        self.prev_slots = {};
+    }
+}
 
-    return value;
+template<typename P>
+void copy(table_t<P>& self, void* buffer, void* prev_buffer, const table_t<P>& src) {
+    memcpy(buffer, src.slots.hashes, buffer_size<P>(src.slots.size));
+    if (is_migrating(src)) {
+        memcpy(prev_buffer, src.prev_slots.hashes, buffer_size<P>(src.prev_slots.size));
+    } else {
+        prev_buffer = nullptr;
+    }
+    self = src;
+    rebase(self, buffer, prev_buffer);
 }
 
-void insert(index_ht_t& self, uint32_t ht_index, uint32_t key_hash, uint32_t value) {
-    // hash_desc_t ht_desc = {};
-    // ht_desc.hashes = self.hashes;
-    // ht_desc.data = self.indices;
-    // ht_desc.element_count = self.size;
-    // uint32_t move_count = hash_rh_insert_move(&s_term_ht_impl, &ht_desc, ht_index);
-    // g_move_count = g_move_count < move_count ? move_count : g_move_count;
+template<typename P>
+uint32_t count(const table_t<P>& self) {
+    return self.slots.count + self.prev_slots.count;
+}
 
-    self.hashes[ht_index] = key_hash;
-    self.indices[ht_index] = value;
+static bool slot_values_in_range(const slots_t& slots, uint32_t value_limit) {
+    uint32_t occupied = 0u;
+    for (uint32_t i = 0; i < slots.size; ++i) {
+        if (!slots.hashes[i]) continue;
+        if (slots.indices[i] >= value_limit) return false;
+        ++occupied;
+    }
+    return occupied == slots.count;
+}
 
-    ++self.count;
+template<typename P>
+bool values_in_range(const table_t<P>& self, uint32_t value_limit) {
+    if (!slot_values_in_range(self.slots, value_limit)) return false;
+    if (!is_migrating(self)) return !self.prev_slots.count;
+    return self.migrated <= self.prev_slots.size && self.migrate_start < self.prev_slots.size && 
+        slot_values_in_range(self.prev_slots, value_limit);
 }
 
-void rehash(index_ht_t& dst_ht, const index_ht_t& src_ht) {
-    hash_desc_t ht_desc = {};
-    ht_desc.hashes = dst_ht.hashes;
-    ht_desc.element_count = dst_ht.size;
+template<typename P>
+bool needs_grow(const table_t<P>& self) {
+    return self.slots.size * P::MAX_LOAD_NUMERATOR < count(self) * P::MAX_LOAD_DENOMINATOR;
+}
 
-    for (size_t i = 0u; i < src_ht.size; ++i) {
-        uint32_t el_hash = src_ht.hashes[i];
-        if (!el_hash) continue;
+template<typename P>
+void grow(table_t<P>& self, void* buffer, uint32_t size) {
+    assert(!is_migrating(self) && "expect previous growth to be migrated");
+    assert(self.slots.size < size);
 
-        // find insert pos
-        auto iter = hash_find_index(&ht_desc, el_hash);
-        for (; iter.hash == el_hash; iter = hash_find_next(&ht_desc, &iter));
+    self.prev_slots = self.slots;
+    init_slots<P>(self.slots, buffer, size);
 
-        insert(dst_ht, iter.index, el_hash, src_ht.indices[i]);
+    // clusters are never split, start at cluster boundary
+    auto& prev = self.prev_slots;
+    self.migrate_start = 0u;
+    while (prev.hashes[self.migrate_start]) {
+        self.migrate_start = (self.migrate_start + 1) & (prev.size - 1);
     }
+    self.migrated = 0u;
 }
 
-hash32_find_iter_t find_index(const index_ht_t& self, uint32_t key_hash, uint32_t* found_index) {
-    hash_desc_t ht_desc = {};
-    ht_desc.hashes = self.hashes;
-    ht_desc.element_count = self.size;
+template<typename P>
+bool is_migrating(const table_t<P>& self) {
+    return self.prev_slots.hashes != nullptr;
+}
 
-    hash32_find_iter_t res = hash_find_index(&ht_desc, key_hash);
-    *found_index = self.indices[res.index];
-    return res;
+template<typename P>
+void* migrate(table_t<P>& self, uint32_t slot_count) {
+    if (!is_migrating(self)) return nullptr;
+
+    auto& prev = self.prev_slots;
+    hash_desc_t prev_desc = make_desc(prev);
+    hash_desc_t ht_desc = make_desc(self.slots);
+
+    for (; self.migrated < prev.size; ++self.migrated) {
+        uint32_t i = (self.migrate_start + self.migrated) & (prev.size - 1);
+        uint32_t el_hash = prev.hashes[i];
+
+        if (el_hash) {
+            // hashes are unique so the key is never found
+            auto iter = P::find_index(&ht_desc, el_hash);
+            assert(iter.hash != el_hash);
+            insert_slot<P>(self.slots, iter.index, el_hash, prev.indices[i]);
+
+            // no shift, the whole cluster is moved before the next lookup
+            P::clear(&prev_desc, i);
+            --prev.count;
+
+        // stop at cluster boundary only, so lookups in the rest of previous slots stay valid
+        } else if (!slot_count) {
+            return nullptr;
+        }
+
+        slot_count -= slot_count ? 1u : 0u;
+    }
+
+    assert(!prev.count);
+    void* drained_buffer = prev.hashes;
+    prev = {};
+    return drained_buffer;
 }
 
-hash32_find_iter_t find_next(const index_ht_t& self, const hash32_find_iter_t* prev_iter, uint32_t* found_index) {
-    hash_desc_t ht_desc = {};
-    ht_desc.hashes = self.hashes;
-    ht_desc.element_count = self.size;
+template<typename P>
+uint32_t erase(table_t<P>& self, uint32_t ht_index) {
+    assert(count(self));
+
+    auto& slots = ht_index < self.slots.size ? self.slots : self.prev_slots;
+    uint32_t slot_index = ht_index < self.slots.size ? ht_index : ht_index - self.slots.size;
+    uint32_t value = slots.indices[slot_index];
+
+    hash_desc_t ht_desc = make_desc(slots);
+    P::erase(&ht_desc, slot_index);
+
+    --slots.count;
+
+    return value;
+}
+
+template<typename P>
+void insert(table_t<P>& self, uint32_t ht_index, uint32_t key_hash, uint32_t value) {
+    assert(ht_index < self.slots.size && "expect insert to current slots only");
+    insert_slot<P>(self.slots, ht_index, key_hash, value);
+}
+
+template<typename P>
+hash32_find_iter_t find_index(const table_t<P>& self, uint32_t key_hash, uint32_t* found_index) {
+    hash_desc_t ht_desc = make_desc(self.slots);
 
-    hash32_find_iter_t res = hash_find_next(&ht_desc, prev_iter);
-    *found_index = self.indices[res.index];
+    hash32_find_iter_t res = P::find_index(&ht_desc, key_hash);
+    if (res.hash != key_hash && self.prev_slots.count) {
+        hash_desc_t prev_desc = make_desc(self.prev_slots);
+        hash32_find_iter_t prev_res = P::find_index(&prev_desc, key_hash);
+        if (prev_res.hash == key_hash) {
+            *found_index = self.prev_slots.indices[prev_res.index];
+            prev_res.index += self.slots.size;
+            return prev_res;
+        }
+    }
+    *found_index = self.slots.indices[res.index];
     return res;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Instantiations
+///////////////////////////////////////////////////////////////////////////////
+
+#define INDEX_HT_INSTANTIATE(P) \
+    template size_t buffer_size<P>(uint32_t size); \
+    template void init(table_t<P>& self, void* buffer, uint32_t size); \
+    template void rebase(table_t<P>& self, void* buffer, void* prev_buffer); \
+    template void copy(table_t<P>& self, void* buffer, void* prev_buffer, const table_t<P>& src); \
+    template uint32_t count(const table_t<P>& self); \
+    template bool values_in_range(const table_t<P>& self, uint32_t value_limit); \
+    template bool needs_grow(const table_t<P>& self); \
+    template void grow(table_t<P>& self, void* buffer, uint32_t size); \
+    template bool is_migrating(const table_t<P>& self); \
+    template void* migrate(table_t<P>& self, uint32_t slot_count); \
+    template uint32_t erase(table_t<P>& self, uint32_t ht_index); \
+    template void insert(table_t<P>& self, uint32_t ht_index, uint32_t key_hash, uint32_t value); \
+    template hash32_find_iter_t find_index(const table_t<P>& self, uint32_t key_hash, uint32_t* found_index);
+
+INDEX_HT_INSTANTIATE(linear_probing_t)
+INDEX_HT_INSTANTIATE(robin_hood_t)
+INDEX_HT_INSTANTIATE(group_probing_t)
+
+#undef INDEX_HT_INSTANTIATE
+
 }
@@ -1,22 +1,114 @@
 #pragma once
 
+#include <cstddef>
 #include "hash_types.h"
 
 namespace index_ht {
 
-struct index_ht_t {
+/**
+ * Probing policies (defined in index_ht.cpp)
+ */
+struct linear_probing_t; // linear probing with backward shift deletion, hash_table.inl
+struct robin_hood_t;     // robin hood with early exit lookup and shift insertion, hash_table_rh.inl
+struct group_probing_t;  // linear probing by groups of control bytes (SSE2/AVX2), hash_table_group.inl
+
+#if defined(TOKOEKA_INDEX_POLICY_ROBIN_HOOD)
+typedef robin_hood_t policy_t;
+#elif defined(TOKOEKA_INDEX_POLICY_GROUP)
+typedef group_probing_t policy_t;
+#else
+typedef linear_probing_t policy_t;
+#endif
+
+struct slots_t {
     uint32_t* hashes;
     uint32_t* indices;
+    uint8_t*  control; // fingerprints, group probing only
     uint32_t  size;
     uint32_t  count;
 };
 
-void init(index_ht_t& self, uint32_t* hashes, uint32_t* indices, uint32_t size);
-uint32_t erase(index_ht_t& self, uint32_t ht_index);
-void insert(index_ht_t& self, uint32_t ht_index, uint32_t key_hash, uint32_t value);
-void rehash(index_ht_t& dst_ht, const index_ht_t& src_ht);
+/**
+ * Open addressing table of 32 bit hashes with 32 bit values,
+ * grows incrementally: previous slots are kept after growth and drained by migrate calls,
+ * lookups check both slot arrays until then
+ */
+template<typename P>
+struct table_t {
+    slots_t  slots;
+    slots_t  prev_slots;    // addressed past slots.size by find_index/erase while migrating
+    uint32_t migrate_start; // empty previous slot, migration moves whole clusters starting from it
+    uint32_t migrated;      // number of previous slots scanned
+};
+
+typedef table_t<policy_t> index_ht_t;
+
+/**
+ * Byte size of the single buffer (hashes, indices and control bytes) for table of size elements
+ */
+template<typename P = policy_t>
+size_t buffer_size(uint32_t size);
+
+template<typename P>
+void init(table_t<P>& self, void* buffer, uint32_t size);
+
+/**
+ * Point table slots into buffers laid out as buffer_size describes, slot contents are kept as is 
+ * (loaded by the caller), sizes and counts are expected to be set, no previous slots if prev_buffer is null
+ */
+template<typename P>
+void rebase(table_t<P>& self, void* buffer, void* prev_buffer);
+
+/**
+ * Copy of the source table within buffers of buffer_size(src.slots.size) and buffer_size(src.prev_slots.size) bytes,
+ * previous slots buffer is used only while the source is migrating
+ */
+template<typename P>
+void copy(table_t<P>& self, void* buffer, void* prev_buffer, const table_t<P>& src);
+
+template<typename P>
+uint32_t count(const table_t<P>& self);
+
+/**
+ * Slot counts are within sizes and values of occupied slots are below value_limit, 
+ * checks tables loaded out of untrusted buffers
+ */
+template<typename P>
+bool values_in_range(const table_t<P>& self, uint32_t value_limit);
+
+template<typename P>
+bool needs_grow(const table_t<P>& self);
+
+/**
+ * Switch to new slots buffer, existing slots are moved with migrate calls
+ */
+template<typename P>
+void grow(table_t<P>& self, void* buffer, uint32_t size);
+
+template<typename P>
+bool is_migrating(const table_t<P>& self);
+
+/**
+ * Move at least slot_count previous slots (completing the last cluster) into the current ones
+ * @return drained previous buffer to free or nullptr
+ */
+template<typename P>
+void* migrate(table_t<P>& self, uint32_t slot_count);
+
+template<typename P>
+uint32_t erase(table_t<P>& self, uint32_t ht_index);
+
+/**
+ * Insert at the slot returned by find_index (occupied slot is shifted for robin hood)
+ */
+template<typename P>
+void insert(table_t<P>& self, uint32_t ht_index, uint32_t key_hash, uint32_t value);
 
-hash32_find_iter_t find_index(const index_ht_t& self, uint32_t key_hash, uint32_t* found_index);
-hash32_find_iter_t find_next(const index_ht_t& self, const hash32_find_iter_t* prev_iter , uint32_t* found_index);
+/**
+ * Find slot of the key hash or slot to insert it, 
+ * stored hashes are expected to be unique (hash is the key)
+ */
+template<typename P>
+hash32_find_iter_t find_index(const table_t<P>& self, uint32_t key_hash, uint32_t* found_index);
 
 }
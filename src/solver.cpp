@@ -15,6 +15,19 @@ const num_t NUM_MAX = DBL_MAX;
 const num_t NUM_EPS = 1e-6;
 const uint32_t FREELIST_INDEX = 0u;
 
+// term index slots moved to the grown table per term insertion
+#if defined(TOKOEKA_INDEX_INCREMENTAL_REHASH)
+const uint32_t INDEX_MIGRATE_SLOT_COUNT = 64u;
+#else
+const uint32_t INDEX_MIGRATE_SLOT_COUNT = ~0u;
+#endif
+
+// add_row scatters target row up to this many times source row terms, hash lookups are used otherwise
+const uint32_t ROW_SCATTER_RATIO = 4u;
+
+// longest chain of variables aliased one to another by required equalities
+const uint32_t MAX_ALIAS_DEPTH = 16u;
+
 enum class symbol_type_e : uint8_t {
     EXTERNAL,
     SLACK,
@@ -24,28 +37,59 @@ enum class symbol_type_e : uint8_t {
 
 struct var_data_t {
     symbol_type_e       type;
+    bool                restricted; // external symbol kept non-negative by native bound
     constraint_handle_t constraint;
     num_t               edit_value;
+    uint32_t            first_ref; // constraint refs list, external variables only
+    // external variable value is offset + scale * symbol value
+    num_t               offset;
+    num_t               scale;
+    // aliased variable value is offset + scale * alias value + marker_scale * alias marker value,
+    // the dummy alias marker keeps variable uses within rows
+    symbol_t            alias;
+    symbol_t            alias_marker;
+    num_t               marker_scale;
+    symbol_t            first_alias; // list of variables aliased to this one
+    symbol_t            next_alias;
+    // connected component of the constraint graph, 0 for variables which were never in a constraint row
+    uint32_t            component;
+    symbol_t            prev_member, next_member; // component symbols list
 };
 
 struct constraint_data_t {
-    symbol_t  marker;
-    symbol_t  other; // nullable
-    num_t     strength;
+    symbol_t   marker;
+    symbol_t   other; // nullable
+    relation_e relation;
+    num_t      strength;
+    num_t      constant;
+    uint32_t  first_ref; // refs list of the constraint terms
+    bool       disabled; // zero strength objective terms, or no row at all for required constraint
+    bool       bound; // native variable bound without row, marker is the variable symbol
+    symbol_t   alias; // variable aliased by required two variable equality without row, marker is the alias marker
+};
+
+/**
+ * Variable term of a constraint as it was added, 
+ * linked into per variable (double linked) and per constraint lists
+ */
+struct constraint_ref_t {
+    constraint_handle_t constraint;
+    symbol_t            var;
+    num_t               multiplier;
+    uint32_t            prev_var_ref;
+    uint32_t            next_var_ref;
+    uint32_t            next_cons_ref;
 };
 
 struct term_coord_t {
     symbol_t row, column;
 };
 
-static bool operator==(const term_coord_t& p1, const term_coord_t& p2) {
-    return p1.row == p2.row && p1.column == p2.column;
-}
-
 struct term_data_t {
     term_coord_t pos;
-    symbol_t     prev_row, next_row;
-    symbol_t     prev_column, next_column;
+    // term indices, stable within sparse term array
+    uint32_t     prev_row, next_row;
+    uint32_t     prev_column, next_column;
     // padding: 4 bytes
     num_t        multiplier;
 };
@@ -71,9 +115,85 @@ struct sparse_array_t {
     uint32_t first_unused_index;
 };
 
+/**
+ * Connected component of the constraint graph, rows of component symbols have terms of component symbols only, 
+ * so components are optimized independently with their own objective rows and infeasible row lists
+ */
+struct component_data_t {
+    symbol_t objective;
+    symbol_t infeasible_rows; // linked by next row of row constant terms
+    uint32_t next_infeasible; // components with infeasible rows list, the last one links itself, 0 if not in the list
+    symbol_t first_member;
+    uint32_t member_count;    // objective included, merge moves members of the smaller component
+};
+
+struct row_scratch_entry_t {
+    uint32_t stamp;
+    uint32_t term_index;
+};
+
+struct dense_row_entry_t {
+    num_t    multiplier;      // mirrored term multiplier at entry column, 0 if no term
+    uint32_t negative_index;  // position + 1 within negative columns set, 0 if multiplier is not negative
+    symbol_t negative_column; // negative columns set element at entry position
+    bool     pinned;          // column never enters the basis (dummy), kept out of negative columns set
+    bool     objective;       // entry symbol is a component objective row, its terms are mirrored
+};
+
+/**
+ * Dense mirror of objective rows indexed by column, a column is in the objective of its component only, 
+ * so a single entry per column serves all of them, the row terms stay in the table as well
+ */
+struct dense_row_t {
+    array_t<dense_row_entry_t> entries;
+    uint32_t negative_count;
+};
+
+struct value_change_t {
+    symbol_t symbol;
+    num_t    prev_value; // value before the first change since tracking start
+};
+
 struct terms_table_t {
     sparse_array_t<term_data_t> terms;
     index_ht::index_ht_t indices;
+    // dense symbol -> term index of the row updated by add_row, 
+    // entries are valid for the current stamp only, so no reset between calls is needed
+    array_t<row_scratch_entry_t> row_scratch;
+    uint32_t row_scratch_stamp;
+    dense_row_t dense_row;
+    // dense symbol -> row constant term multiplier, that is the value of basic symbol, 0 if symbol has no row
+    array_t<num_t> row_values;
+    // symbols with changed row values, dense symbol -> position + 1 within changes, 0 if not changed
+    array_t<value_change_t> value_changes;
+    array_t<uint32_t> value_change_positions;
+    uint32_t value_change_count;
+};
+
+struct edit_box_t {
+    num_t min;
+    num_t max;
+};
+
+/**
+ * Solved bases visited by suggest, each is a solver snapshot with the edit ranges it stays feasible for, 
+ * entries are dropped by any change other than suggest
+ */
+struct basis_cache_t {
+    uint32_t capacity;
+    uint32_t count;
+    uint32_t next;    // round robin replacement position
+    uint32_t current; // entry position + 1 of the solver basis, 0 if it is not stored
+    array_t<solver_t*> snapshots; // capacity entries, made by the first store into the entry
+    // edit variables of stored entries, the set is the same for all of them
+    array_t<symbol_t> edit_vars;
+    uint32_t edit_var_count;
+    array_t<uint32_t> edit_positions; // dense symbol -> position + 1 within edit variables
+    array_t<edit_box_t> boxes;        // edit variable ranges of entries, edit_var_count per entry
+    array_t<num_t> targets;           // suggested values of all edit variables
+    // row values and value changes kept across the restore
+    array_t<num_t> saved_values;
+    array_t<value_change_t> saved_changes;
 };
 
 } // internal namespace
@@ -83,10 +203,13 @@ struct solver_t {
 
     sparse_array_t<var_data_t> vars;
     sparse_array_t<constraint_data_t> constraints;
+    sparse_array_t<constraint_ref_t> refs;
 
     terms_table_t terms;
-    symbol_t objective;
-    symbol_t infeasible_rows; // use next constant term row links for infeasible rows
+    uint32_t mapped_var_count; // variables with non identity value mapping
+    sparse_array_t<component_data_t> components;
+    uint32_t infeasible_components; // components with infeasible rows, linked by next_infeasible
+    basis_cache_t* basis_cache; // optional, see set_basis_cache
 };
 
 namespace {
@@ -143,6 +266,33 @@ static void array_grow(allocator_t* alloc, array_t<T>* arr, size_t desired_size)
     arr->size = array_mem.size / sizeof(T);
 }
 
+/**
+ * Get element reference, array is grown with zeroed elements to contain position
+ */
+template<typename T>
+static T& array_get_grow(allocator_t* alloc, array_t<T>* arr, size_t position) {
+    auto size = array_size(arr);
+    if (position >= size) {
+        array_grow(alloc, arr, size * 2 > position ? size * 2 : position + 1);
+        memset(arr->entries + size, 0, (array_size(arr) - size) * sizeof(T));
+    }
+    return array_get(*arr, position);
+}
+
+/**
+ * Copy array elements, destination is grown to the source size if needed and the rest of it is zeroed
+ */
+template<typename T>
+static void array_copy(allocator_t* alloc, array_t<T>* dst, const array_t<T>* src) {
+    if (array_size(dst) < array_size(src)) {
+        if (dst->entries) free_array(alloc, dst);
+        *dst = {};
+        array_grow(alloc, dst, array_size(src));
+    }
+    memcpy(dst->entries, src->entries, array_size(src) * sizeof(T));
+    memset(dst->entries + array_size(src), 0, (array_size(dst) - array_size(src)) * sizeof(T));
+}
+
 /* sparse_array_t */
 
 template<typename T>
@@ -202,6 +352,36 @@ static uint32_t array_add(allocator_t* alloc, sparse_array_t<T>& arr, const T& v
     return new_index;
 }
 
+/**
+ * Grow array to fit count more elements past the first unused one
+ */
+template<typename T>
+static void array_reserve(allocator_t* alloc, sparse_array_t<T>& arr, size_t count) {
+    const size_t desired_size = arr.first_unused_index + count;
+    size_t new_size = array_size(&arr.array);
+    if (desired_size <= new_size) return;
+
+    while (new_size < desired_size) new_size *= 2;
+    array_grow(alloc, &arr.array, new_size);
+}
+
+/**
+ * Add count copies of v at consecutive unused elements (free list is skipped), 
+ * @return index of the first one
+ */
+template<typename T>
+static uint32_t array_add_range(allocator_t* alloc, sparse_array_t<T>& arr, uint32_t count, const T& v) {
+    array_reserve(alloc, arr, count);
+
+    uint32_t first_index = arr.first_unused_index;
+    for (uint32_t i = 0; i < count; ++i) {
+        array_get(arr, first_index + i) = v;
+    }
+    arr.first_unused_index += count;
+
+    return first_index;
+}
+
 template<typename T>
 static void array_remove(sparse_array_t<T>& arr, uint32_t index) {
     assert(index);
@@ -211,29 +391,44 @@ static void array_remove(sparse_array_t<T>& arr, uint32_t index) {
     free_list_head_entry.next = index;
 }
 
+/**
+ * Copy used elements and the free list, unused elements are not copied
+ */
+template<typename T>
+static void array_copy(allocator_t* alloc, sparse_array_t<T>& dst, const sparse_array_t<T>& src) {
+    if (array_size(&dst.array) < array_size(&src.array)) {
+        if (dst.array.entries) free_array(alloc, &dst.array);
+        dst.array = {};
+        array_grow(alloc, &dst.array, array_size(&src.array));
+    }
+    memcpy(dst.array.entries, src.array.entries, src.first_unused_index * sizeof(typename sparse_array_t<T>::entry_t));
+    dst.first_unused_index = src.first_unused_index;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Term hash table 
 ///////////////////////////////////////////////////////////////////////////////
 
-/// hash a single byte
-static uint32_t fnv1a_hash(uint8_t oneByte, uint32_t hash) {
-    const uint32_t Prime = 0x01000193; //   16777619
-    return (oneByte ^ hash) * Prime;
-}
-
-const uint32_t fnv1a_seed  = 0x811C9DC5; // 2166136261
-static uint32_t fnv1a_hash(uint16_t twoBytes, uint32_t hash = fnv1a_seed) {
-    const uint8_t* ptr = (const uint8_t*) &twoBytes;
-    hash = fnv1a_hash(*ptr++, hash);
-    return fnv1a_hash(*ptr  , hash);
+/// pack term coordinate into a single 32 bit key, {0, 0} is never used as a term key
+static uint32_t pack_uint32_t(const term_coord_t& pos) {
+    return (uint32_t)pos.row | ((uint32_t)pos.column << 16);
 }
 
+/**
+ * Invertible 32 bit mix (murmur3 finalizer) of the packed coordinate, 
+ * so stored slot hash is the key itself: hash match means key match without touching term data,
+ * zero maps to zero only, so any valid key gives non-zero hash
+ */
 static uint32_t hash_uint32_t(const term_coord_t& pos) {
-    uint32_t hash = fnv1a_hash(pos.row);
-    uint32_t res = fnv1a_hash(pos.column, hash);
+    assert(pos.row || pos.column);
 
-    res += (res == 0u) ? 1u : 0u;
-    return res;
+    uint32_t hash = pack_uint32_t(pos);
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bu;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35u;
+    hash ^= hash >> 16;
+    return hash;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -243,15 +438,226 @@ static uint32_t hash_uint32_t(const term_coord_t& pos) {
 static void init_table(allocator_t* alloc, terms_table_t* terms, size_t page_size) {
     array_init(alloc, terms->terms, page_size);
 
-    auto indices_mem = allocate(alloc, page_size);
     uint32_t size = (uint32_t)page_size / (sizeof(uint32_t) * 2);
-    uint32_t* indices_buf = (uint32_t*)indices_mem.ptr;
-    index_ht::init(terms->indices, indices_buf, indices_buf + size, size);
+    auto indices_mem = allocate(alloc, index_ht::buffer_size(size));
+    index_ht::init(terms->indices, indices_mem.ptr, size);
+
+    array_grow(alloc, &terms->row_scratch, page_size / sizeof(row_scratch_entry_t));
+    memset(terms->row_scratch.entries, 0, array_size(&terms->row_scratch) * sizeof(row_scratch_entry_t));
+    terms->row_scratch_stamp = 0u;
+
+    auto dense_row = &terms->dense_row;
+    array_grow(alloc, &dense_row->entries, page_size / sizeof(dense_row_entry_t));
+    memset(dense_row->entries.entries, 0, array_size(&dense_row->entries) * sizeof(dense_row_entry_t));
+    dense_row->negative_count = 0u;
+
+    array_grow(alloc, &terms->row_values, page_size / sizeof(num_t));
+    memset(terms->row_values.entries, 0, array_size(&terms->row_values) * sizeof(num_t));
+
+    array_grow(alloc, &terms->value_changes, page_size / sizeof(value_change_t));
+    array_grow(alloc, &terms->value_change_positions, page_size / sizeof(uint32_t));
+    memset(terms->value_change_positions.entries, 0, array_size(&terms->value_change_positions) * sizeof(uint32_t));
+    terms->value_change_count = 0u;
 }
 
 static void free_table(allocator_t* alloc, terms_table_t* terms) {
-    free(alloc, terms->indices.hashes); // hashes + indices chunk
+    free(alloc, terms->indices.slots.hashes); // hashes + indices chunk
+    if (index_ht::is_migrating(terms->indices)) {
+        free(alloc, terms->indices.prev_slots.hashes);
+    }
     free_array(alloc, terms->terms);
+    free_array(alloc, &terms->row_scratch);
+    free_array(alloc, &terms->dense_row.entries);
+    free_array(alloc, &terms->row_values);
+    free_array(alloc, &terms->value_changes);
+    free_array(alloc, &terms->value_change_positions);
+}
+
+/**
+ * Copy the table into destination buffers, the ones of matching sizes are reused
+ */
+static void copy_table(allocator_t* alloc, terms_table_t* dst, const terms_table_t* src) {
+    array_copy(alloc, dst->terms, src->terms);
+
+    // index slots are addressed by size, the buffer is reused for the same size only
+    auto& dst_indices = dst->indices;
+    const auto& src_indices = src->indices;
+    void* buffer = dst_indices.slots.hashes;
+    if (buffer && dst_indices.slots.size != src_indices.slots.size) {
+        free(alloc, buffer);
+        buffer = nullptr;
+    }
+    if (!buffer) buffer = allocate(alloc, index_ht::buffer_size(src_indices.slots.size)).ptr;
+    void* prev_buffer = dst_indices.prev_slots.hashes;
+    if (prev_buffer && (!index_ht::is_migrating(src_indices) || dst_indices.prev_slots.size != src_indices.prev_slots.size)) {
+        free(alloc, prev_buffer);
+        prev_buffer = nullptr;
+    }
+    if (!prev_buffer && index_ht::is_migrating(src_indices)) {
+        prev_buffer = allocate(alloc, index_ht::buffer_size(src_indices.prev_slots.size)).ptr;
+    }
+    index_ht::copy(dst_indices, buffer, prev_buffer, src_indices);
+
+    array_copy(alloc, &dst->row_scratch, &src->row_scratch);
+    dst->row_scratch_stamp = src->row_scratch_stamp;
+
+    array_copy(alloc, &dst->dense_row.entries, &src->dense_row.entries);
+    dst->dense_row.negative_count = src->dense_row.negative_count;
+
+    array_copy(alloc, &dst->row_values, &src->row_values);
+    array_copy(alloc, &dst->value_changes, &src->value_changes);
+    array_copy(alloc, &dst->value_change_positions, &src->value_change_positions);
+    dst->value_change_count = src->value_change_count;
+}
+
+/* dense row */
+
+static void dense_row_set(dense_row_entry_t* entries, dense_row_t* dense_row, symbol_t column, num_t multiplier) {
+    auto& entry = entries[column];
+    entry.multiplier = multiplier;
+
+    const bool negative = multiplier < 0.0f && !entry.pinned;
+    if (negative && !entry.negative_index) {
+        entries[dense_row->negative_count].negative_column = column;
+        entry.negative_index = ++dense_row->negative_count;
+    } else if (!negative && entry.negative_index) {
+        // move the last set element into the freed position
+        auto position = entry.negative_index - 1;
+        auto last_column = entries[--dense_row->negative_count].negative_column;
+        entries[position].negative_column = last_column;
+        entries[last_column].negative_index = position + 1;
+        entry.negative_index = 0u;
+    }
+}
+
+/**
+ * Keep column out of negative columns set, 
+ * so the set holds entering candidates only and is empty for the optimal row
+ */
+static void dense_row_pin(allocator_t* alloc, terms_table_t* terms, symbol_t column, bool pinned) {
+    auto dense_row = &terms->dense_row;
+    auto& entry = array_get_grow(alloc, &dense_row->entries, column);
+    entry.pinned = pinned;
+    dense_row_set(dense_row->entries.entries, dense_row, column, entry.multiplier);
+}
+
+/**
+ * Row is a component objective with terms mirrored by dense row entries
+ */
+static bool is_dense_row(const terms_table_t* terms, symbol_t row) {
+    auto entries = &terms->dense_row.entries;
+    return row < array_size(entries) && entries->entries[row].objective;
+}
+
+/**
+ * Start or stop mirroring row terms, entries are kept as is,
+ * so the row is expected to have no column terms or to have them mirrored by another marked row
+ */
+static void dense_row_mark(allocator_t* alloc, terms_table_t* terms, symbol_t row, bool objective) {
+    array_get_grow(alloc, &terms->dense_row.entries, row).objective = objective;
+}
+
+/* value changes */
+
+/**
+ * Grow value change arrays along with row values, 
+ * so value changes are tracked without allocations for symbols with mirrored values
+ */
+static void reserve_value_changes(allocator_t* alloc, terms_table_t* terms, symbol_t symbol) {
+    array_get_grow(alloc, &terms->value_change_positions, symbol);
+    array_get_grow(alloc, &terms->value_changes, symbol);
+}
+
+static void track_value_change(terms_table_t* terms, symbol_t symbol, num_t prev_value) {
+    auto& position = array_get(terms->value_change_positions, symbol);
+    if (position) return;
+
+    array_get(terms->value_changes, terms->value_change_count) = {symbol, prev_value};
+    position = ++terms->value_change_count;
+}
+
+static void untrack_value_change(terms_table_t* terms, symbol_t symbol) {
+    if (symbol >= array_size(&terms->value_change_positions)) return;
+
+    auto& position = array_get(terms->value_change_positions, symbol);
+    if (!position) return;
+
+    // move the last change into the freed position
+    auto last_change = array_get(terms->value_changes, --terms->value_change_count);
+    array_get(terms->value_changes, position - 1) = last_change;
+    array_get(terms->value_change_positions, last_change.symbol) = position;
+    position = 0u;
+}
+
+/**
+ * Shift tracked previous value of the symbol, symbol is tracked if it was not
+ */
+static void rebase_value_change(allocator_t* alloc, terms_table_t* terms, symbol_t symbol, num_t delta) {
+    reserve_value_changes(alloc, terms, symbol);
+    auto position = array_get(terms->value_change_positions, symbol);
+    if (position) {
+        array_get(terms->value_changes, position - 1).prev_value += delta;
+        return;
+    }
+
+    num_t value = symbol < array_size(&terms->row_values) ? array_get(terms->row_values, symbol) : 0.0f;
+    track_value_change(terms, symbol, value + delta);
+}
+
+/* dense mirrors of term multipliers */
+
+/**
+ * Update row values and dense row with the changed term multiplier, 
+ * expected to be called on every term multiplier modification
+ */
+static void term_changed(allocator_t* alloc, terms_table_t* terms, const term_data_t* term) {
+    if (!term->pos.column) {
+        reserve_value_changes(alloc, terms, term->pos.row);
+        auto& row_value = array_get_grow(alloc, &terms->row_values, term->pos.row);
+        if (row_value != term->multiplier) {
+            track_value_change(terms, term->pos.row, row_value);
+            row_value = term->multiplier;
+        }
+        return;
+    }
+
+    auto dense_row = &terms->dense_row;
+    if (!is_dense_row(terms, term->pos.row)) return;
+
+    array_get_grow(alloc, &dense_row->entries, term->pos.column);
+    dense_row_set(dense_row->entries.entries, dense_row, term->pos.column, term->multiplier);
+}
+
+static void term_erased(terms_table_t* terms, const term_data_t* term) {
+    // symbol list head is erased with the symbol itself
+    if (!term->pos.row) {
+        untrack_value_change(terms, term->pos.column);
+        return;
+    }
+
+    // no mirrored value beyond array sizes, nothing to reset
+    if (!term->pos.column) {
+        if (term->pos.row < array_size(&terms->row_values)) {
+            auto& row_value = array_get(terms->row_values, term->pos.row);
+            if (row_value != 0.0f) {
+                track_value_change(terms, term->pos.row, row_value);
+                row_value = 0.0f;
+            }
+        }
+        return;
+    }
+
+    auto dense_row = &terms->dense_row;
+    if (!is_dense_row(terms, term->pos.row)) return;
+
+    if (term->pos.column < array_size(&dense_row->entries)) {
+        dense_row_set(dense_row->entries.entries, dense_row, term->pos.column, 0.0f);
+    }
+}
+
+static num_t dense_row_multiplier(terms_table_t* terms, symbol_t column) {
+    auto entries = &terms->dense_row.entries;
+    return column < array_size(entries) ? array_get(*entries, column).multiplier : 0.0f;
 }
 
 typedef struct {
@@ -264,11 +670,8 @@ static index_result_t get_term_index_no_assert(terms_table_t* terms, const term_
     auto coord_h = hash_uint32_t(coord);
     uint32_t term_index = 0u;
     auto iter = index_ht::find_index(terms->indices, coord_h, &term_index);
-    for (; iter.hash == coord_h; 
-            iter = index_ht::find_next(terms->indices, &iter, &term_index)) {
-        if (coord == array_get(terms->terms, term_index).pos) {
-            return {iter.index, term_index, true};
-        }
+    if (iter.hash == coord_h) {
+        return {iter.index, term_index, true};
     }
     return {iter.index, ~0u, false};
 }
@@ -279,26 +682,38 @@ static term_data_t* get_term(terms_table_t* terms, const term_coord_t& coord, ui
     term_data_t* res = &array_get(terms->terms, index_res.index);
     assert(res->pos.row == coord.row && res->pos.column == coord.column);
 
-    if (out_index) *out_index = index_res.ht_index;
+    if (out_index) *out_index = index_res.index;
     return res;
 }
 
-static void table_grow_rehash(allocator_t* alloc, index_ht::index_ht_t* indices) {
-    auto new_size = indices->size * 2;
-    auto indices_mem = allocate(alloc, sizeof(uint32_t) * new_size * 2); // multiple of initial page size
-    uint32_t* indices_buf = (uint32_t*)indices_mem.ptr;
-    index_ht::index_ht_t new_indices = {};
-    index_ht::init(new_indices, indices_buf, indices_buf + new_size, new_size);
+/**
+ * Grow term index if needed and move a bounded number of its slots into the grown buffer
+ * @return true if index slots were changed
+ */
+static bool table_grow_step(allocator_t* alloc, index_ht::index_ht_t* indices) {
+    bool grow = index_ht::needs_grow(*indices);
+    if (grow) {
+        // unlikely to grow again before migration is complete, drain it at once
+        if (void* drained_buf = index_ht::migrate(*indices, ~0u)) {
+            free(alloc, drained_buf);
+        }
+
+        auto new_size = indices->slots.size * 2;
+        auto indices_mem = allocate(alloc, index_ht::buffer_size(new_size)); // multiple of initial page size
+        index_ht::grow(*indices, indices_mem.ptr, new_size);
+    }
 
-    index_ht::rehash(new_indices, *indices);
-    free(alloc, indices->hashes); // hashes + indices chunk
+    if (!index_ht::is_migrating(*indices)) return grow;
 
-    *indices = new_indices;
+    if (void* drained_buf = index_ht::migrate(*indices, INDEX_MIGRATE_SLOT_COUNT)) {
+        free(alloc, drained_buf); // hashes + indices chunk
+    }
+    return true;
 }
 
 typedef struct {
     term_data_t* term;
-    uint32_t     index;
+    uint32_t     index; // term index
 } term_result_t;
 
 static term_result_t get_term_result(terms_table_t* terms, const term_coord_t& coord) {
@@ -310,44 +725,52 @@ static term_result_t get_term_result(terms_table_t* terms, const term_coord_t& c
 static term_result_t find_term(terms_table_t* terms, const term_coord_t& coord) {
     term_result_t res = {};
     auto index_res = get_term_index_no_assert(terms, coord);
-    res.index = index_res.ht_index;
     if (index_res.found) {
         res.term = &array_get(terms->terms, index_res.index);
+        res.index = index_res.index;
     }
 
     return res;
 }
 
 static term_data_t* find_existing_term(terms_table_t* terms, const term_coord_t& coord) {
-     term_result_t res = find_term(terms, coord);
-     if (res.term && 
-        res.term->pos.row == coord.row &&
-        res.term->pos.column == coord.column) {
-            return res.term;
-        }
+    term_result_t res = find_term(terms, coord);
+    assert(!res.term || (res.term->pos.row == coord.row && res.term->pos.column == coord.column));
+    return res.term;
+}
 
-    return nullptr;
+static term_data_t* term_at(terms_table_t* terms, uint32_t term_index) {
+    return &array_get(terms->terms, term_index);
 }
 
 static int is_constant_row(terms_table_t* terms, symbol_t row) {
     term_coord_t key = {row, 0u};
-    auto term = get_term(terms, key);
-    return term->next_column == 0u;
+    uint32_t head_index = 0u;
+    auto term = get_term(terms, key, &head_index);
+    return term->next_column == head_index;
 }
 
+/**
+ * Row and column lists are circular and linked by term indices, 
+ * list head is the row constant term {row, 0} or the symbol term {0, column},
+ * hash lookup is needed only to find the head
+ */
 typedef struct {
     term_result_t term_res;
-    term_coord_t next_coord;
+    uint32_t      next_index;
+    uint32_t      head_index;
 } term_iterator_t;
 
 static term_iterator_t first_symbol_iterator(terms_table_t* terms, symbol_t sym) {
     term_iterator_t res = {};
 
-    auto sym_list = get_term(terms, {0u, sym});
-    if (!sym_list->next_row) return res;
+    uint32_t head_index = 0u;
+    auto sym_list = get_term(terms, {0u, sym}, &head_index);
+    if (sym_list->next_row == head_index) return res;
 
-    res.term_res = get_term_result(terms, {sym_list->next_row, sym});
-    res.next_coord = {res.term_res.term->next_row, sym};
+    res.term_res = {term_at(terms, sym_list->next_row), sym_list->next_row};
+    res.next_index = res.term_res.term->next_row;
+    res.head_index = head_index;
 
     return res;
 }
@@ -355,35 +778,41 @@ static term_iterator_t first_symbol_iterator(terms_table_t* terms, symbol_t sym)
 static term_iterator_t next_symbol_iterator(terms_table_t* terms, const term_iterator_t& iter) {
     term_iterator_t res = {};
 
-    if (!iter.next_coord.row) return res;
+    if (iter.next_index == iter.head_index) return res;
 
-    res.term_res = get_term_result(terms, iter.next_coord);
-    res.next_coord = {res.term_res.term->next_row, iter.next_coord.column};
+    res.term_res = {term_at(terms, iter.next_index), iter.next_index};
+    res.next_index = res.term_res.term->next_row;
+    res.head_index = iter.head_index;
 
     return res;
 }
 
-typedef struct {
-    term_result_t term_res;
-    term_coord_t next_coord;
-} term_row_iterator_t;
+typedef term_iterator_t term_row_iterator_t;
 
-static term_row_iterator_t first_row_iterator(terms_table_t* terms, symbol_t row) {
+static term_row_iterator_t head_row_iterator(terms_table_t* terms, uint32_t head_index) {
     term_row_iterator_t res = {};
 
-    res.term_res = get_term_result(terms, {row, 0u});
-    res.next_coord = {row, res.term_res.term->next_column};
+    res.term_res = {term_at(terms, head_index), head_index};
+    res.next_index = res.term_res.term->next_column;
+    res.head_index = head_index;
 
     return res;
 }
 
+static term_row_iterator_t first_row_iterator(terms_table_t* terms, symbol_t row) {
+    uint32_t head_index = 0u;
+    get_term(terms, {row, 0u}, &head_index);
+    return head_row_iterator(terms, head_index);
+}
+
 static term_row_iterator_t next_row_iterator(terms_table_t* terms, const term_row_iterator_t& iter) {
     term_row_iterator_t res = {};
 
-    if (!iter.next_coord.column) return res;
+    if (iter.next_index == iter.head_index) return res;
 
-    res.term_res = get_term_result(terms, iter.next_coord);
-    res.next_coord = {iter.next_coord.row, res.term_res.term->next_column};
+    res.term_res = {term_at(terms, iter.next_index), iter.next_index};
+    res.next_index = res.term_res.term->next_column;
+    res.head_index = iter.head_index;
 
     return res;
 }
@@ -393,47 +822,39 @@ static term_row_iterator_t first_row_term_iterator(terms_table_t* terms, symbol_
     return next_row_iterator(terms, res);
 }
 
-static void link_term(terms_table_t* terms, term_coord_t coord, term_data_t& new_term) {
+static void link_term(terms_table_t* terms, term_coord_t coord, uint32_t new_term_index) {
     // link in row
     {
-        // update head link
-        term_coord_t row_head_key = {coord.row, 0};
-        auto row_head_term = get_term(terms, row_head_key);
-
-        auto last_col = row_head_term->prev_column;
-        row_head_term->prev_column = coord.column;
+        uint32_t head_index = 0u;
+        auto row_head_term = get_term(terms, {coord.row, 0u}, &head_index);
+        auto last_index = row_head_term->prev_column;
+        row_head_term->prev_column = new_term_index;
 
-        // update tail link
-        term_coord_t row_tail_key = {coord.row, last_col};
-        auto tail_term = last_col == 0u ? row_head_term : get_term(terms, row_tail_key);
-
-        assert(tail_term->next_column == 0u);
-        tail_term->next_column = coord.column;
+        auto tail_term = term_at(terms, last_index);
+        assert(tail_term->next_column == head_index);
+        tail_term->next_column = new_term_index;
 
         // new term links
-        new_term.prev_column = last_col;
-        new_term.next_column = 0u;
+        auto new_term = term_at(terms, new_term_index);
+        new_term->prev_column = last_index;
+        new_term->next_column = head_index;
     }
 
     // link in var list
     {
-        // update head link
-        term_coord_t col_key = {0, coord.column};
-        auto col_term = get_term(terms, col_key);
-
-        auto last_row = col_term->prev_row;
-        col_term->prev_row = coord.row;
+        uint32_t head_index = 0u;
+        auto col_term = get_term(terms, {0u, coord.column}, &head_index);
+        auto last_index = col_term->prev_row;
+        col_term->prev_row = new_term_index;
 
-        // update tail link
-        term_coord_t tail_key = {last_row, coord.column};
-        auto tail_term = last_row == 0u ? col_term : get_term(terms, tail_key);
-
-        assert(tail_term->next_row == 0u);
-        tail_term->next_row = coord.row;
+        auto tail_term = term_at(terms, last_index);
+        assert(tail_term->next_row == head_index);
+        tail_term->next_row = new_term_index;
 
         // new term links
-        new_term.prev_row = last_row;
-        new_term.next_row = 0u;
+        auto new_term = term_at(terms, new_term_index);
+        new_term->prev_row = last_index;
+        new_term->next_row = head_index;
     }
 }
 
@@ -447,39 +868,34 @@ enum unlink_frags_e : uint8_t {
 static void unlink_term(terms_table_t* terms, const term_data_t* t, unlink_frags_e unlink_flag) {
     // unlink row
     if (unlink_flag & unlink_frags_e::ROW) {
-        assert(get_term(terms, {t->pos.row, t->prev_column})->next_column == t->pos.column);
-        assert(get_term(terms, {t->pos.row, t->next_column})->prev_column == t->pos.column);
-
-        term_coord_t prev_coord = {t->pos.row, t->prev_column};
-        auto prev_term = get_term(terms, prev_coord);
-
-        prev_term->next_column = t->next_column;
-
-        term_coord_t next_coord = {t->pos.row, t->next_column};
-        auto next_term = t->prev_column == t->next_column ? prev_term : get_term(terms, next_coord);
-        next_term->prev_column = t->prev_column;
-
-        assert(get_term(terms, {t->pos.row, t->prev_column})->next_column == t->next_column);
-        assert(get_term(terms, {t->pos.row, t->next_column})->prev_column == t->prev_column);
+        assert(t->prev_column && t->next_column);
+        term_at(terms, t->prev_column)->next_column = t->next_column;
+        term_at(terms, t->next_column)->prev_column = t->prev_column;
     }
 
     // unlink column
     if (unlink_flag & unlink_frags_e::COLUMN) {
-        term_coord_t prev_coord = {t->prev_row, t->pos.column};
-        auto prev_term = get_term(terms, prev_coord);
-        prev_term->next_row = t->next_row;
-
-        term_coord_t next_coord = {t->next_row, t->pos.column};
-        auto next_term = t->prev_row == t->next_row ? prev_term : get_term(terms, next_coord);
-        next_term->prev_row = t->prev_row;
+        assert(t->prev_row && t->next_row);
+        term_at(terms, t->prev_row)->next_row = t->next_row;
+        term_at(terms, t->next_row)->prev_row = t->prev_row;
     }
 }
 
+static void erase_term(terms_table_t* terms, uint32_t ht_index, uint32_t term_index, 
+                       unlink_frags_e unlink_flag) {
+    auto term = term_at(terms, term_index);
+    term_erased(terms, term);
+    unlink_term(terms, term, unlink_flag);
+    auto term_pos = index_ht::erase(terms->indices, ht_index);
+    assert(term_pos == term_index);
+    array_remove(terms->terms, term_pos);
+}
+
 static void delete_term(terms_table_t* terms, const term_result_t* term_it, 
                         unlink_frags_e unlink_flag = unlink_frags_e::BOTH) {
-    unlink_term(terms, term_it->term, unlink_flag);
-    auto term_pos = index_ht::erase(terms->indices, term_it->index);
-    array_remove(terms->terms, term_pos);
+    auto index_res = get_term_index_no_assert(terms, term_it->term->pos);
+    assert(index_res.found && index_res.index == term_it->index);
+    erase_term(terms, index_res.ht_index, term_it->index, unlink_flag);
 }
 
 static void free_row(terms_table_t* terms, symbol_t row) {
@@ -491,57 +907,151 @@ static void free_row(terms_table_t* terms, symbol_t row) {
     }
 }
 
-static void multiply_row(terms_table_t* terms, symbol_t row, num_t multiplier) {
+static void multiply_row(allocator_t* alloc, terms_table_t* terms, symbol_t row, num_t multiplier) {
     for (auto term_it = first_row_iterator(terms, row); 
             term_it.term_res.term;
             term_it = next_row_iterator(terms, term_it)) {
         auto term_ptr = term_it.term_res.term;
 
         term_ptr->multiplier *= multiplier;
+        term_changed(alloc, terms, term_ptr);
+    }
+}
+
+/**
+ * Add zero term at key missing in the table, index_res is the failed lookup result
+ * and is updated to point to the new term
+ */
+static void insert_term(allocator_t* alloc, terms_table_t* terms, const term_coord_t& key, index_result_t* index_res) {
+    assert(!index_res->found);
+    assert(index_res->ht_index != ~0u && "expect ht to grow?");
+
+    term_data_t new_term = {};
+    new_term.pos = key;
+
+    auto new_term_index = array_add(alloc, terms->terms, new_term);
+    assert(new_term_index);
+
+    if (key.row && key.column) {
+        link_term(terms, key, new_term_index);
+    } else if (key.row) {
+        // row head, constant term next_row is used for infeasible rows list
+        auto head = term_at(terms, new_term_index);
+        head->prev_column = head->next_column = new_term_index;
+    } else {
+        // symbol list head
+        auto head = term_at(terms, new_term_index);
+        head->prev_row = head->next_row = new_term_index;
     }
+
+    if (table_grow_step(alloc, &terms->indices)) {
+        *index_res = get_term_index_no_assert(terms, key);
+    }
+    index_ht::insert(terms->indices, index_res->ht_index, hash_uint32_t(key), new_term_index);
+    index_res->index = new_term_index;
+    index_res->found = true;
 }
 
 static void add_term(allocator_t* alloc, terms_table_t* terms, symbol_t row, symbol_t sym, num_t value) {
     const term_coord_t key = {row, sym};
-    auto var_term_it = find_term(terms, key);
-    assert(var_term_it.index != ~0u && "expect ht to grow?");
-
-    if (!var_term_it.term) {
+    auto index_res = get_term_index_no_assert(terms, key);
+    if (!index_res.found) {
         // no var, add
+        insert_term(alloc, terms, key, &index_res);
+    }
 
-        term_data_t new_term = {};
-        new_term.pos = key;
-        if (row && sym) {
-            // todo: cache row terms for multiple add_term calls for single row
-            link_term(terms, key, new_term);
-        }
+    auto term = term_at(terms, index_res.index);
+    term->multiplier += value;
+    term_changed(alloc, terms, term);
+    if (row && sym && near_zero(term->multiplier)) {
+        // delete key
+        erase_term(terms, index_res.ht_index, index_res.index, unlink_frags_e::BOTH);
+    }
+}
 
+static row_scratch_entry_t& row_scratch_at(allocator_t* alloc, terms_table_t* terms, symbol_t column) {
+    return array_get_grow(alloc, &terms->row_scratch, column);
+}
 
-        auto new_term_index = array_add(alloc, terms->terms, new_term);
-        assert(new_term_index);
-        
-        if (terms->indices.size < terms->indices.count * 2) {
-            table_grow_rehash(alloc, &terms->indices);
-            var_term_it = find_term(terms, key);
-        }
-        index_ht::insert(terms->indices, var_term_it.index, hash_uint32_t(key), new_term_index);
-        var_term_it.term = &array_get(terms->terms, new_term_index);
+static void next_row_scratch_stamp(terms_table_t* terms) {
+    if (!++terms->row_scratch_stamp) {
+        // wrapped, invalidate stale entries
+        memset(terms->row_scratch.entries, 0, array_size(&terms->row_scratch) * sizeof(row_scratch_entry_t));
+        terms->row_scratch_stamp = 1u;
     }
+}
 
-    var_term_it.term->multiplier += value;
-    if (row && sym && near_zero(var_term_it.term->multiplier)) {
-        // delete key
-        delete_term(terms, &var_term_it);
+/**
+ * Scatter row term indices into the dense scratch by column
+ * @return false if row has more than max_term_count terms
+ */
+static bool scatter_row(allocator_t* alloc, terms_table_t* terms, uint32_t head_index, uint32_t max_term_count) {
+    next_row_scratch_stamp(terms);
+
+    uint32_t term_count = 0u;
+    for (auto term_it = head_row_iterator(terms, head_index); 
+            term_it.term_res.term;
+            term_it = next_row_iterator(terms, term_it)) {
+        if (term_count++ == max_term_count) return false;
+        row_scratch_at(alloc, terms, term_it.term_res.term->pos.column) = {terms->row_scratch_stamp, term_it.term_res.index};
     }
+    return true;
 }
 
+/**
+ * row += other * multiplier with a sparse accumulator: 
+ * row term indices are scattered into the dense scratch by column,
+ * so other row terms are merged without hash lookups except for the new ones.
+ * Rows much longer than other (objective) are updated by term lookups instead.
+ */
 static void add_row(allocator_t* alloc, terms_table_t* terms, symbol_t row, symbol_t other, num_t multiplier) {
+    uint32_t other_term_count = 0u;
     for (auto term_it = first_row_iterator(terms, other); 
             term_it.term_res.term;
             term_it = next_row_iterator(terms, term_it)) {
-        auto term_ptr = term_it.term_res.term;
+        ++other_term_count;
+    }
+
+    // target row is created by pivot and artificial variable substitution
+    const term_coord_t head_key = {row, 0u};
+    auto head_res = get_term_index_no_assert(terms, head_key);
+    if (!head_res.found) {
+        insert_term(alloc, terms, head_key, &head_res);
+    }
+
+    if (!scatter_row(alloc, terms, head_res.index, other_term_count * ROW_SCATTER_RATIO)) {
+        for (auto term_it = first_row_iterator(terms, other); 
+                term_it.term_res.term;
+                term_it = next_row_iterator(terms, term_it)) {
+            auto term_ptr = term_it.term_res.term;
+
+            add_term(alloc, terms, row, term_ptr->pos.column, term_ptr->multiplier * multiplier);
+        }
+        return;
+    }
+
+    for (auto term_it = first_row_iterator(terms, other); 
+            term_it.term_res.term;
+            term_it = next_row_iterator(terms, term_it)) {
+        const symbol_t column = term_it.term_res.term->pos.column;
+        const num_t value = term_it.term_res.term->multiplier * multiplier;
+
+        auto& scratch_entry = row_scratch_at(alloc, terms, column);
+        uint32_t term_index = scratch_entry.stamp == terms->row_scratch_stamp ? scratch_entry.term_index : 0u;
+        if (!term_index) {
+            const term_coord_t key = {row, column};
+            auto index_res = get_term_index_no_assert(terms, key);
+            insert_term(alloc, terms, key, &index_res);
+            term_index = index_res.index;
+        }
 
-        add_term(alloc, terms, row, term_ptr->pos.column, term_ptr->multiplier * multiplier);
+        // term array might be grown by insertion, no term pointers are kept
+        term_result_t term_res = {term_at(terms, term_index), term_index};
+        term_res.term->multiplier += value;
+        term_changed(alloc, terms, term_res.term);
+        if (column && near_zero(term_res.term->multiplier)) {
+            delete_term(terms, &term_res);
+        }
     }
 }
 
@@ -574,12 +1084,19 @@ static var_data_t* get_var_data(solver_t *solver, symbol_t var) {
     return &array_get(solver->vars, var);
 }
 
+/**
+ * Unrestricted external symbol
+ */
 static bool is_external(solver_t* solver, symbol_t key) {
-    return get_var_data(solver, key)->type == symbol_type_e::EXTERNAL;
+    auto var_data = get_var_data(solver, key);
+    return var_data->type == symbol_type_e::EXTERNAL && !var_data->restricted;
 }
 
-static bool is_slack(solver_t* solver, symbol_t key) {
-    return get_var_data(solver, key)->type == symbol_type_e::SLACK;
+/**
+ * External symbol, either restricted or not
+ */
+static bool is_variable(solver_t* solver, symbol_t key) {
+    return get_var_data(solver, key)->type == symbol_type_e::EXTERNAL;
 }
 
 static bool is_error(solver_t* solver, symbol_t key) {
@@ -591,17 +1108,69 @@ static bool is_dummy(solver_t* solver, symbol_t key) {
 }
 
 static bool is_pivotable(solver_t* solver, symbol_t key) {
-    return (is_slack(solver, key) || is_error(solver, key));
+    auto var_data = get_var_data(solver, key);
+    return var_data->type == symbol_type_e::SLACK || var_data->type == symbol_type_e::ERROR || var_data->restricted;
+}
+
+/**
+ * Symbol value within the tableau, that is row constant of basic symbol or 0
+ */
+static num_t row_value(solver_t *solver, symbol_t sym) {
+    auto row_values = &solver->terms.row_values;
+    num_t res = sym < array_size(row_values) ? array_get(*row_values, sym) : 0.0f;
+    assert(res == (has_row(&solver->terms, sym) ? get_term(&solver->terms, {sym, 0u})->multiplier : 0.0f));
+    return res;
+}
+
+static bool is_mapped(const var_data_t* var_data) {
+    return var_data->offset != 0.0f || var_data->scale != 1.0f || var_data->alias;
+}
+
+static component_data_t* component_data(solver_t *solver, uint32_t component) {
+    return &array_get(solver->components, component);
+}
+
+static void add_member(solver_t *solver, uint32_t component, symbol_t sym) {
+    auto comp = component_data(solver, component);
+    auto var_data = get_var_data(solver, sym);
+    assert(!var_data->component);
+    var_data->component = component;
+    var_data->prev_member = 0u;
+    var_data->next_member = comp->first_member;
+    if (comp->first_member) get_var_data(solver, comp->first_member)->prev_member = sym;
+    comp->first_member = sym;
+    comp->member_count++;
+}
+
+static void remove_member(solver_t *solver, symbol_t sym) {
+    auto var_data = get_var_data(solver, sym);
+    auto comp = component_data(solver, var_data->component);
+    if (var_data->prev_member) {
+        get_var_data(solver, var_data->prev_member)->next_member = var_data->next_member;
+    } else {
+        comp->first_member = var_data->next_member;
+    }
+    if (var_data->next_member) get_var_data(solver, var_data->next_member)->prev_member = var_data->prev_member;
+    comp->member_count--;
+    var_data->component = 0u;
+    var_data->prev_member = var_data->next_member = 0u;
 }
 
-static symbol_t new_symbol(solver_t *solver, symbol_type_e type) {
+/**
+ * @param component component to join, 0 for symbols which are not a part of constraint rows
+ */
+static symbol_t new_symbol(solver_t *solver, symbol_type_e type, uint32_t component) {
     var_data_t data = {};
     data.type = type;
+    data.scale = 1.0f;
     symbol_t id = array_add(&solver->allocator, solver->vars, data);
 
     // init symbol link list
     add_term(&solver->allocator, &solver->terms, 0u, id, 0.0f);
 
+    if (type == symbol_type_e::DUMMY) dense_row_pin(&solver->allocator, &solver->terms, id, true);
+    if (component) add_member(solver, component, id);
+
     return id;
 }
 
@@ -609,32 +1178,175 @@ static constraint_data_t* constraint_data(solver_t *solver, constraint_handle_t
     return &array_get(solver->constraints, cons_id);
 }
 
-/* Cassowary algorithm */
+/* connected components */
 
-static void mark_infeasible(solver_t *solver, term_data_t* row_term) {
-    if (row_term->multiplier < 0.0f && !row_term->next_row) {
-        row_term->next_row = solver->infeasible_rows ? solver->infeasible_rows : row_term->pos.row;
-        solver->infeasible_rows = row_term->pos.row;
-    }
-}
+static uint32_t new_component(solver_t *solver) {
+    symbol_t objective = new_symbol(solver, symbol_type_e::EXTERNAL, 0u);
+    init_row(&solver->allocator, &solver->terms, objective, 0.0f);
+    dense_row_mark(&solver->allocator, &solver->terms, objective, true);
 
-static void mark_infeasible(solver_t *solver, symbol_t row) {
-    auto row_term = get_term(&solver->terms, {row, 0u});
-    mark_infeasible(solver, row_term);
+    component_data_t data = {};
+    data.objective = objective;
+    uint32_t component = array_add(&solver->allocator, solver->components, data);
+    add_member(solver, component, objective);
+    return component;
 }
 
-static void pivot(solver_t *solver, symbol_t row, symbol_t entry, symbol_t exit) {
-    assert(!has_row(&solver->terms, entry));
-
-    term_coord_t key = {row, entry};
-    auto term_it = get_term_result(&solver->terms, key);
-    num_t reciprocal = 1.0f / term_it.term->multiplier;
-    assert(entry != exit && !near_zero(term_it.term->multiplier));
-    delete_term(&solver->terms, &term_it);
+static symbol_t component_objective(solver_t *solver, symbol_t sym) {
+    return component_data(solver, get_var_data(solver, sym)->component)->objective;
+}
 
-    add_row(&solver->allocator, &solver->terms, entry, row, -reciprocal);
-    free_row(&solver->terms, row);
-    if (row != exit) delete_variable(solver, row);
+static bool is_objective(solver_t *solver, symbol_t sym) {
+    uint32_t component = get_var_data(solver, sym)->component;
+    return component && component_data(solver, component)->objective == sym;
+}
+
+/**
+ * Drop component left with its objective only, the objective row has the constant term only then
+ */
+static void release_component(solver_t *solver, uint32_t component) {
+    auto comp = component_data(solver, component);
+    symbol_t objective = comp->objective;
+    assert(comp->member_count == 1 && comp->first_member == objective);
+    assert(!comp->infeasible_rows && !comp->next_infeasible);
+    assert(is_constant_row(&solver->terms, objective));
+
+    remove_member(solver, objective);
+    array_remove(solver->components, component);
+    dense_row_mark(&solver->allocator, &solver->terms, objective, false);
+    free_row(&solver->terms, objective);
+    delete_variable(solver, objective);
+}
+
+static void unqueue_component(solver_t *solver, uint32_t component) {
+    uint32_t prev = 0u;
+    for (uint32_t it = solver->infeasible_components; ; ) {
+        uint32_t next = component_data(solver, it)->next_infeasible;
+        bool last = next == it;
+        if (it == component) {
+            uint32_t after = last ? 0u : next;
+            if (prev) {
+                component_data(solver, prev)->next_infeasible = after ? after : prev;
+            } else {
+                solver->infeasible_components = after;
+            }
+            component_data(solver, it)->next_infeasible = 0u;
+            return;
+        }
+        assert(!last);
+        prev = it;
+        it = next;
+    }
+}
+
+static void mark_infeasible(solver_t *solver, term_data_t* row_term);
+
+/**
+ * Merge the smaller component into the larger one, 
+ * objective rows are summed as they have no common columns
+ * @return merged component
+ */
+static uint32_t merge_components(solver_t *solver, uint32_t first, uint32_t second) {
+    uint32_t dst = first, src = second;
+    if (component_data(solver, dst)->member_count < component_data(solver, src)->member_count) {
+        dst = second;
+        src = first;
+    }
+
+    symbol_t src_objective = component_data(solver, src)->objective;
+    symbol_t dst_objective = component_data(solver, dst)->objective;
+    add_row(&solver->allocator, &solver->terms, dst_objective, src_objective, 1.0f);
+    // source columns are mirrored by destination objective terms now
+    dense_row_mark(&solver->allocator, &solver->terms, src_objective, false);
+    free_row(&solver->terms, src_objective);
+
+    // queued rows are moved to the merged component after relabeling
+    symbol_t src_rows = component_data(solver, src)->infeasible_rows;
+    component_data(solver, src)->infeasible_rows = 0u;
+    if (component_data(solver, src)->next_infeasible) unqueue_component(solver, src);
+
+    remove_member(solver, src_objective);
+    while (symbol_t sym = component_data(solver, src)->first_member) {
+        remove_member(solver, sym);
+        add_member(solver, dst, sym);
+    }
+    array_remove(solver->components, src);
+    delete_variable(solver, src_objective);
+
+    for (symbol_t row = src_rows; row; ) {
+        auto row_term = get_term(&solver->terms, {row, 0u});
+        symbol_t next = row_term->next_row != row ? row_term->next_row : 0u;
+        row_term->next_row = 0u;
+        mark_infeasible(solver, row_term);
+        row = next;
+    }
+    return dst;
+}
+
+/**
+ * @param component component to join, 0 to take the symbol one or to start a new one
+ * @return component of the symbol
+ */
+static uint32_t join_symbol(solver_t *solver, uint32_t component, symbol_t sym) {
+    uint32_t sym_component = get_var_data(solver, sym)->component;
+    if (!sym_component) {
+        if (!component) component = new_component(solver);
+        add_member(solver, component, sym);
+        return component;
+    }
+    if (!component || component == sym_component) return sym_component;
+    return merge_components(solver, component, sym_component);
+}
+
+/**
+ * Join variable along with its alias chain, aliased variables share the component of the target
+ */
+static uint32_t join_variable(solver_t *solver, uint32_t component, symbol_t var) {
+    for (symbol_t sym = var; sym; ) {
+        auto var_data = get_var_data(solver, sym);
+        symbol_t alias = var_data->alias, alias_marker = var_data->alias_marker;
+        component = join_symbol(solver, component, sym);
+        if (alias_marker) component = join_symbol(solver, component, alias_marker);
+        sym = alias;
+    }
+    return component;
+}
+
+/* Cassowary algorithm */
+
+static void mark_infeasible(solver_t *solver, term_data_t* row_term) {
+    // rounding leftovers of primal pivots are feasible for dual_optimize as well, so they are not queued
+    if (row_term->multiplier < 0.0f && !near_zero(row_term->multiplier) && !row_term->next_row) {
+        uint32_t component = get_var_data(solver, row_term->pos.row)->component;
+        auto comp = component_data(solver, component);
+        row_term->next_row = comp->infeasible_rows ? comp->infeasible_rows : row_term->pos.row;
+        comp->infeasible_rows = row_term->pos.row;
+
+        // component is queued along with its first row
+        if (!comp->next_infeasible) {
+            comp->next_infeasible = solver->infeasible_components ? solver->infeasible_components : component;
+            solver->infeasible_components = component;
+        }
+    }
+}
+
+static void mark_infeasible(solver_t *solver, symbol_t row) {
+    auto row_term = get_term(&solver->terms, {row, 0u});
+    mark_infeasible(solver, row_term);
+}
+
+static void pivot(solver_t *solver, symbol_t row, symbol_t entry, symbol_t exit) {
+    assert(!has_row(&solver->terms, entry));
+
+    term_coord_t key = {row, entry};
+    auto term_it = get_term_result(&solver->terms, key);
+    num_t reciprocal = 1.0f / term_it.term->multiplier;
+    assert(entry != exit && !near_zero(term_it.term->multiplier));
+    delete_term(&solver->terms, &term_it);
+
+    add_row(&solver->allocator, &solver->terms, entry, row, -reciprocal);
+    free_row(&solver->terms, row);
+    if (row != exit) delete_variable(solver, row);
 
     if (exit != 0) add_term(&solver->allocator, &solver->terms, entry, exit, reciprocal);
 
@@ -655,26 +1367,42 @@ static void pivot(solver_t *solver, symbol_t row, symbol_t entry, symbol_t exit)
     }
 
     // reset entry symbol list as symbol links were not updated in delete_term
-    auto entry_list_term = get_term(&solver->terms, {0, entry});
-    entry_list_term->next_row = entry_list_term->prev_row = 0u;
+    uint32_t entry_list_index = 0u;
+    auto entry_list_term = get_term(&solver->terms, {0, entry}, &entry_list_index);
+    entry_list_term->next_row = entry_list_term->prev_row = entry_list_index;
 }
 
 static result_e optimize(solver_t *solver, symbol_t objective) {
     for (;;) {
-        assert(solver->infeasible_rows == 0);
+        assert(solver->infeasible_components == 0);
 
         // find entering symbol
         symbol_t enter = 0u;
-        for (auto term_it = first_row_term_iterator(&solver->terms, objective);
-                term_it.term_res.term;
-                term_it = next_row_iterator(&solver->terms, term_it)) {
-            auto term_ptr = term_it.term_res.term;
-
-            if (!is_dummy(solver, term_ptr->pos.column) && 
-                    term_ptr->multiplier < 0.0f) { 
-                enter = term_ptr->pos.column; 
-                break; 
-            }        
+        auto dense_row = &solver->terms.dense_row;
+        if (is_dense_row(&solver->terms, objective)) {
+            // lowest negative symbol of the objective component from the dense set, dummy columns are pinned out of it,
+            // columns of other components are left in the set until their objectives are optimized
+            uint32_t component = get_var_data(solver, objective)->component;
+            for (uint32_t i = 0; i < dense_row->negative_count; ++i) {
+                symbol_t column = array_get(dense_row->entries, i).negative_column;
+                assert(!is_dummy(solver, column));
+                if (get_var_data(solver, column)->component != component) continue;
+                if (!enter || column < enter) {
+                    enter = column;
+                }
+            }
+        } else {
+            for (auto term_it = first_row_term_iterator(&solver->terms, objective);
+                    term_it.term_res.term;
+                    term_it = next_row_iterator(&solver->terms, term_it)) {
+                auto term_ptr = term_it.term_res.term;
+
+                if (!is_dummy(solver, term_ptr->pos.column) && 
+                        term_ptr->multiplier < 0.0f) { 
+                    enter = term_ptr->pos.column; 
+                    break; 
+                }        
+            }
         }
 
         if (enter == 0) return result_e::OK;
@@ -695,7 +1423,7 @@ static result_e optimize(solver_t *solver, symbol_t objective) {
                     term_multiplier >= 0.0f) 
                 continue;
 
-            num_t r = -value(solver, it_row) / term_multiplier;
+            num_t r = -row_value(solver, it_row) / term_multiplier;
             if (r < min_ratio) {
                 min_ratio = r;
                 exit = it_row;
@@ -711,46 +1439,109 @@ static result_e optimize(solver_t *solver, symbol_t objective) {
     }
 }
 
-static symbol_t make_row(solver_t *solver, const constraint_desc_t* desc, constraint_data_t* cons) {
-    // use temp var to form the row
-    symbol_t row = new_symbol(solver, symbol_type_e::SLACK);
-    init_row(&solver->allocator, &solver->terms, row, -desc->constant);
-    for (size_t i = 0; i < desc->term_count; ++i) {
-        merge_row(&solver->allocator, &solver->terms, row, desc->symbols[i], desc->multipliers[i]);
+/**
+ * Optimize objectives of components with entering candidates, that is of components changed since the last optimize
+ */
+static result_e optimize_changed(solver_t *solver) {
+    auto dense_row = &solver->terms.dense_row;
+    while (dense_row->negative_count) {
+        symbol_t column = array_get(dense_row->entries, 0).negative_column;
+        result_e ret = optimize(solver, component_objective(solver, column));
+        if (ret != result_e::OK) return ret;
     }
+    return result_e::OK;
+}
 
-    if (desc->relation != relation_e::EQUAL) {
-        num_t coeff = desc->relation == relation_e::LESSEQUAL ? 1.0f : -1.0f;
-        cons->marker = new_symbol(solver, symbol_type_e::SLACK);
+/**
+ * Add marker and error symbols to the row of constraint terms, row sign is normalized for non-negative value
+ */
+static void add_row_markers(solver_t *solver, symbol_t row, constraint_data_t* cons) {
+    uint32_t component = get_var_data(solver, row)->component;
+    symbol_t objective = component_data(solver, component)->objective;
+    if (cons->relation != relation_e::EQUAL) {
+        num_t coeff = cons->relation == relation_e::LESSEQUAL ? 1.0f : -1.0f;
+        cons->marker = new_symbol(solver, symbol_type_e::SLACK, component);
         add_term(&solver->allocator, &solver->terms, row, cons->marker, coeff);
         if (cons->strength < STRENGTH_REQUIRED) {
-            cons->other = new_symbol(solver, symbol_type_e::ERROR);
+            cons->other = new_symbol(solver, symbol_type_e::ERROR, component);
             add_term(&solver->allocator, &solver->terms, row, cons->other, -coeff);
-            add_term(&solver->allocator, &solver->terms, solver->objective, cons->other, cons->strength);
+            add_term(&solver->allocator, &solver->terms, objective, cons->other, cons->strength);
         }
     } else if (cons->strength >= STRENGTH_REQUIRED) {
-        cons->marker = new_symbol(solver, symbol_type_e::DUMMY);
+        cons->marker = new_symbol(solver, symbol_type_e::DUMMY, component);
         add_term(&solver->allocator, &solver->terms, row, cons->marker, 1.0f);
     } else {
-        cons->marker = new_symbol(solver, symbol_type_e::ERROR);
-        cons->other = new_symbol(solver, symbol_type_e::ERROR);
+        cons->marker = new_symbol(solver, symbol_type_e::ERROR, component);
+        cons->other = new_symbol(solver, symbol_type_e::ERROR, component);
         add_term(&solver->allocator, &solver->terms, row, cons->marker, -1.0f);
         add_term(&solver->allocator, &solver->terms, row, cons->other,   1.0f);
-        add_term(&solver->allocator, &solver->terms, solver->objective, cons->marker, cons->strength);
-        add_term(&solver->allocator, &solver->terms, solver->objective, cons->other,  cons->strength);
+        add_term(&solver->allocator, &solver->terms, objective, cons->marker, cons->strength);
+        add_term(&solver->allocator, &solver->terms, objective, cons->other,  cons->strength);
+    }
+    if (row_value(solver, row) < 0.0f) multiply_row(&solver->allocator, &solver->terms, row, -1.0f);
+}
+
+/**
+ * Merge variable term into the row through the variable value mapping
+ */
+static void merge_var(solver_t *solver, symbol_t row, symbol_t var, num_t multiplier) {
+    auto var_data = get_var_data(solver, var);
+    if (var_data->offset != 0.0f) {
+        add_term(&solver->allocator, &solver->terms, row, 0u, multiplier * var_data->offset);
+    }
+    if (var_data->alias) {
+        merge_row(&solver->allocator, &solver->terms, row, var_data->alias_marker, multiplier * var_data->marker_scale);
+        merge_var(solver, row, var_data->alias, multiplier * var_data->scale);
+        return;
+    }
+    merge_row(&solver->allocator, &solver->terms, row, var, multiplier * var_data->scale);
+}
+
+static symbol_t make_row(solver_t *solver, const constraint_desc_t* desc, constraint_data_t* cons) {
+    // constraint joins components of its variables
+    uint32_t component = 0u;
+    for (size_t i = 0; i < desc->term_count; ++i) {
+        component = join_variable(solver, component, desc->symbols[i]);
+    }
+    if (!component) component = new_component(solver);
+
+    // use temp var to form the row
+    symbol_t row = new_symbol(solver, symbol_type_e::SLACK, component);
+    init_row(&solver->allocator, &solver->terms, row, -desc->constant);
+    for (size_t i = 0; i < desc->term_count; ++i) {
+        merge_var(solver, row, desc->symbols[i], desc->multipliers[i]);
     }
-    if (value(solver, row) < 0.0f) multiply_row(&solver->terms, row, -1.0f);
+
+    add_row_markers(solver, row, cons);
     return row;
 }
 
+static bool has_errors(solver_t *solver, const constraint_data_t *cons) {
+    return is_error(solver, cons->marker) || (cons->other && is_error(solver, cons->other));
+}
+
+static void add_errors(solver_t *solver, constraint_data_t *cons) {
+    if (!has_errors(solver, cons)) return;
+
+    symbol_t objective = component_objective(solver, cons->marker);
+    if (is_error(solver, cons->marker))
+        merge_row(&solver->allocator, &solver->terms, objective, cons->marker, cons->strength);
+    if (cons->other && is_error(solver, cons->other))
+        merge_row(&solver->allocator, &solver->terms, objective, cons->other, cons->strength);
+}
+
 static void remove_errors(solver_t *solver, constraint_data_t *cons) {
+    if (!has_errors(solver, cons)) return;
+
+    symbol_t objective = component_objective(solver, cons->marker);
     if (is_error(solver, cons->marker))
-        merge_row(&solver->allocator, &solver->terms, solver->objective, cons->marker, -cons->strength);
+        merge_row(&solver->allocator, &solver->terms, objective, cons->marker, -cons->strength);
     if (cons->other && is_error(solver, cons->other))
-        merge_row(&solver->allocator, &solver->terms, solver->objective, cons->other, -cons->strength);
-    if (is_constant_row(&solver->terms, solver->objective)) {
-        auto obj_constant_term = get_term(&solver->terms, {solver->objective, 0u});
+        merge_row(&solver->allocator, &solver->terms, objective, cons->other, -cons->strength);
+    if (is_constant_row(&solver->terms, objective)) {
+        auto obj_constant_term = get_term(&solver->terms, {objective, 0u});
         obj_constant_term->multiplier = 0.0f;
+        term_changed(&solver->allocator, &solver->terms, obj_constant_term);
     }
 }
 
@@ -770,24 +1561,264 @@ static symbol_t get_leaving_row(solver_t *solver, symbol_t marker) {
         if (is_external(solver, it_row))
             third = it_row;
         else if (term_multiplier < 0.0f) {
-            num_t r = -value(solver, it_row) / term_multiplier;
+            num_t r = -row_value(solver, it_row) / term_multiplier;
             if (r < r1) r1 = r, first = it_row;
         } else {
-            num_t r = value(solver, it_row) / term_multiplier;
+            num_t r = row_value(solver, it_row) / term_multiplier;
             if (r < r2) r2 = r, second = it_row;
         }
     }
     return first ? first : second ? second : third;
 }
 
+static void add_constraint_refs(solver_t *solver, constraint_handle_t cons, const constraint_desc_t* desc) {
+    for (size_t i = 0; i < desc->term_count; ++i) {
+        symbol_t var = desc->symbols[i];
+
+        constraint_ref_t ref = {};
+        ref.constraint = cons;
+        ref.var = var;
+        ref.multiplier = desc->multipliers[i];
+        ref.next_var_ref = get_var_data(solver, var)->first_ref;
+        ref.next_cons_ref = constraint_data(solver, cons)->first_ref;
+        uint32_t ref_index = array_add(&solver->allocator, solver->refs, ref);
+
+        if (ref.next_var_ref) array_get(solver->refs, ref.next_var_ref).prev_var_ref = ref_index;
+        get_var_data(solver, var)->first_ref = ref_index;
+        constraint_data(solver, cons)->first_ref = ref_index;
+    }
+}
+
+static void remove_constraint_refs(solver_t *solver, constraint_handle_t cons) {
+    auto cons_data = constraint_data(solver, cons);
+    for (uint32_t ref_index = cons_data->first_ref; ref_index; ) {
+        const auto ref = array_get(solver->refs, ref_index);
+
+        // unlink from variable refs
+        if (ref.prev_var_ref) {
+            array_get(solver->refs, ref.prev_var_ref).next_var_ref = ref.next_var_ref;
+        } else {
+            get_var_data(solver, ref.var)->first_ref = ref.next_var_ref;
+        }
+        if (ref.next_var_ref) {
+            array_get(solver->refs, ref.next_var_ref).prev_var_ref = ref.prev_var_ref;
+        }
+
+        array_remove(solver->refs, ref_index);
+        ref_index = ref.next_cons_ref;
+    }
+    cons_data->first_ref = 0u;
+}
+
+/**
+ * Tracked previous value of the variable in the variable value terms, current value if not tracked
+ */
+static num_t prev_variable_value(solver_t *solver, symbol_t var) {
+    auto terms = &solver->terms;
+    uint32_t position = var < array_size(&terms->value_change_positions) ? 
+        array_get(terms->value_change_positions, var) : 0u;
+    if (!position) return value(solver, var);
+
+    auto var_data = get_var_data(solver, var);
+    num_t prev_value = array_get(terms->value_changes, position - 1).prev_value;
+    return var_data->alias ? prev_value : var_data->offset + var_data->scale * prev_value;
+}
+
+/**
+ * Replace tracked previous value of the variable, 
+ * the value is in the variable value terms for aliased variables and in symbol value terms otherwise
+ */
+static void retrack_value_change(solver_t *solver, symbol_t var, num_t prev_value) {
+    untrack_value_change(&solver->terms, var);
+    reserve_value_changes(&solver->allocator, &solver->terms, var);
+    track_value_change(&solver->terms, var, prev_value);
+}
+
+/**
+ * Constraint is a single variable required inequality, the variable is not in the tableau yet 
+ * and has no bound, so the bound is set by the variable value mapping instead of a row
+ */
+static bool is_native_bound(solver_t *solver, const constraint_desc_t* desc) {
+    if (desc->term_count != 1 || 
+            desc->relation == relation_e::EQUAL || 
+            desc->strength < STRENGTH_REQUIRED ||
+            near_zero(desc->multipliers[0]))
+        return false;
+
+    symbol_t var = desc->symbols[0];
+    auto var_data = get_var_data(solver, var);
+    return var_data->type == symbol_type_e::EXTERNAL && 
+        !var_data->restricted && 
+        !var_data->alias &&
+        !is_objective(solver, var) &&
+        !has_row(&solver->terms, var) && 
+        !first_symbol_iterator(&solver->terms, var).term_res.term;
+}
+
+/**
+ * Bind unused variable as x = bound + symbol (lower bound) or x = bound - symbol (upper bound), 
+ * symbol is restricted to be non-negative
+ */
+static void add_native_bound(solver_t *solver, const constraint_desc_t* desc, constraint_data_t* cons) {
+    symbol_t var = desc->symbols[0];
+    num_t multiplier = desc->multipliers[0];
+    bool lower = (desc->relation == relation_e::GREATEQUAL) == (multiplier > 0.0f);
+
+    auto var_data = get_var_data(solver, var);
+    if (!is_mapped(var_data)) solver->mapped_var_count++;
+
+    // unused symbol value is 0, no rows to update
+    num_t prev_value = prev_variable_value(solver, var);
+    var_data->offset = desc->constant / multiplier;
+    var_data->scale = lower ? 1.0f : -1.0f;
+    var_data->restricted = true;
+
+    // keep tracked previous value in the new mapping terms
+    retrack_value_change(solver, var, (prev_value - var_data->offset) / var_data->scale);
+
+    cons->marker = var;
+    cons->bound = true;
+}
+
+/**
+ * Lift restriction of the bound variable symbol, the symbol is pivoted into the basis if possible
+ * as unrestricted symbols are preferred basic ones (see choose_subject)
+ */
+static void remove_native_bound(solver_t *solver, constraint_data_t* cons) {
+    symbol_t var = cons->marker;
+    auto var_data = get_var_data(solver, var);
+    if (!var_data->restricted) return;
+
+    var_data->restricted = false;
+    if (!has_row(&solver->terms, var) && first_symbol_iterator(&solver->terms, var).term_res.term) {
+        symbol_t exit = get_leaving_row(solver, var);
+        if (exit) pivot(solver, exit, var, exit);
+    }
+}
+
+/**
+ * Variable is not in the tableau yet and can be an alias of the target variable
+ */
+static bool can_alias(solver_t *solver, symbol_t var, symbol_t target) {
+    auto var_data = get_var_data(solver, var);
+    if (var_data->type != symbol_type_e::EXTERNAL || 
+            var_data->restricted || 
+            var_data->alias || 
+            is_objective(solver, var) ||
+            has_row(&solver->terms, var) || 
+            first_symbol_iterator(&solver->terms, var).term_res.term)
+        return false;
+
+    if (!is_variable(solver, target) || is_objective(solver, target)) return false;
+    // no alias cycles, chains are short to keep merge_var and value cheap
+    uint32_t depth = 0;
+    for (symbol_t t = target; t; t = get_var_data(solver, t)->alias) {
+        if (t == var || ++depth > MAX_ALIAS_DEPTH) return false;
+    }
+    return true;
+}
+
+/**
+ * Constraint is a required two variable equality with a variable to alias
+ * @return term index of the variable to alias, -1 if none
+ */
+static int alias_term_index(solver_t *solver, const constraint_desc_t* desc) {
+    if (desc->term_count != 2 || 
+            desc->relation != relation_e::EQUAL || 
+            desc->strength < STRENGTH_REQUIRED ||
+            near_zero(desc->multipliers[0]) || near_zero(desc->multipliers[1]) ||
+            desc->symbols[0] == desc->symbols[1])
+        return -1;
+
+    for (int i = 0; i < 2; ++i) {
+        if (can_alias(solver, desc->symbols[i], desc->symbols[1 - i])) return i;
+    }
+    return -1;
+}
+
+/**
+ * Substitute the variable by its alias, m * x + mt * t = c makes x = c / m - mt / m * t - marker / m
+ * (marker coefficient is 1, see add_row_markers), the variable row is implicit
+ */
+static void add_alias(solver_t *solver, const constraint_desc_t* desc, int index, constraint_data_t* cons) {
+    symbol_t var = desc->symbols[index];
+    symbol_t target = desc->symbols[1 - index];
+    num_t multiplier = desc->multipliers[index];
+
+    num_t prev_value = prev_variable_value(solver, var);
+    uint32_t component = join_variable(solver, join_variable(solver, 0u, target), var);
+    symbol_t marker = new_symbol(solver, symbol_type_e::DUMMY, component);
+
+    auto var_data = get_var_data(solver, var);
+    if (!is_mapped(var_data)) solver->mapped_var_count++;
+    var_data->alias = target;
+    var_data->alias_marker = marker;
+    var_data->offset = desc->constant / multiplier;
+    var_data->scale = -desc->multipliers[1 - index] / multiplier;
+    var_data->marker_scale = -1.0f / multiplier;
+
+    auto target_data = get_var_data(solver, target);
+    var_data->next_alias = target_data->first_alias;
+    target_data->first_alias = var;
+
+    retrack_value_change(solver, var, prev_value);
+
+    cons->marker = marker;
+    cons->alias = var;
+}
+
+/**
+ * Make the implicit aliased variable row, var = offset + scale * alias + marker_scale * marker,
+ * the marker is removed as any required equality marker then
+ */
+static void remove_alias(solver_t *solver, constraint_data_t* cons) {
+    symbol_t var = cons->alias;
+    num_t prev_value = prev_variable_value(solver, var);
+
+    auto var_data = get_var_data(solver, var);
+    const symbol_t target = var_data->alias;
+    const num_t offset = var_data->offset;
+    const num_t scale = var_data->scale;
+    const num_t marker_scale = var_data->marker_scale;
+
+    symbol_t* link = &get_var_data(solver, target)->first_alias;
+    while (*link != var) link = &get_var_data(solver, *link)->next_alias;
+    *link = var_data->next_alias;
+
+    var_data->alias = var_data->alias_marker = var_data->next_alias = 0u;
+    var_data->offset = var_data->marker_scale = 0.0f;
+    var_data->scale = 1.0f;
+    solver->mapped_var_count--;
+
+    init_row(&solver->allocator, &solver->terms, var, offset);
+    merge_var(solver, var, target, scale);
+    add_term(&solver->allocator, &solver->terms, var, cons->marker, marker_scale);
+
+    // the value is the same, tracked in symbol terms again
+    retrack_value_change(solver, var, prev_value);
+    cons->alias = 0u;
+}
+
+/**
+ * Remove constraint row and its symbols out of tableau, refs and constraint data are kept
+ */
 static void remove_vars(solver_t *solver, constraint_handle_t cons) {
     if (!cons) return;
 
     auto cons_data = constraint_data(solver, cons);
-    assert(cons_data->marker);
+    // disabled required constraint has no row
+    if (!cons_data->marker) return;
+
+    if (cons_data->bound) {
+        remove_native_bound(solver, cons_data);
+        return;
+    }
+
+    if (cons_data->alias) remove_alias(solver, cons_data);
 
     symbol_t marker = cons_data->marker;
-    remove_errors(solver, cons_data);
+    // disabled constraint errors are out of objective already
+    if (!cons_data->disabled) remove_errors(solver, cons_data);
 
     if (!has_row(&solver->terms, marker)) {
         symbol_t exit = get_leaving_row(solver, marker);
@@ -797,20 +1828,28 @@ static void remove_vars(solver_t *solver, constraint_handle_t cons) {
     free_row(&solver->terms, marker);
     delete_variable(solver, cons_data->marker);
     delete_variable(solver, cons_data->other);
+    cons_data->marker = cons_data->other = 0u;
+}
 
-    optimize(solver, solver->objective);
+static void remove_constraint_no_optimize(solver_t *solver, constraint_handle_t cons) {
+    remove_constraint_refs(solver, cons);
+    remove_vars(solver, cons);
+
+    // link to free list
+    array_remove(solver->constraints, cons);
 }
 
 static result_e add_with_artificial(solver_t *solver, symbol_t row) {
-    symbol_t a = new_symbol(solver, symbol_type_e::SLACK); /* artificial variable will be removed */
+    symbol_t a = new_symbol(solver, symbol_type_e::SLACK, get_var_data(solver, row)->component); /* artificial variable will be removed */
     add_row(&solver->allocator, &solver->terms, a, row, 1.0f);
 
     optimize(solver, row);
-    result_e ret = near_zero(value(solver, row)) ? result_e::OK : result_e::UNBOUND;
+    result_e ret = near_zero(row_value(solver, row)) ? result_e::OK : result_e::UNBOUND;
     free_row(&solver->terms, row);
     delete_variable(solver, row);
     if (has_row(&solver->terms, a)) {
-        if (is_constant_row(&solver->terms, a)) { 
+        // artificial symbol is used by the added row only, so dropping its row drops the unsatisfied one
+        if (ret != result_e::OK || is_constant_row(&solver->terms, a)) { 
             free_row(&solver->terms, a);
             delete_variable(solver, a);
             return ret; 
@@ -834,7 +1873,8 @@ static result_e add_with_artificial(solver_t *solver, symbol_t row) {
             delete_variable(solver, a);
             return result_e::UNBOUND; 
         }
-        pivot(solver, a, entry, 0u);
+        // keep artificial symbol, its column is removed below
+        pivot(solver, a, entry, a);
     }
 
     // remove artificial variable column
@@ -844,7 +1884,9 @@ static result_e add_with_artificial(solver_t *solver, symbol_t row) {
         delete_term(&solver->terms, &sym_iter.term_res, unlink_frags_e::ROW);
     }
     // reset next row to pass delete_variable assert, ifdef with NDEBUG?
-    get_term(&solver->terms, {0, a})->next_row = 0u;
+    uint32_t a_list_index = 0u;
+    auto a_list_term = get_term(&solver->terms, {0, a}, &a_list_index);
+    a_list_term->next_row = a_list_index;
     delete_variable(solver, a);
     
     return ret;
@@ -883,7 +1925,7 @@ static result_e try_addrow(solver_t *solver, symbol_t row, const constraint_data
     bool all_terms_dummy = false;
     symbol_t subject = choose_subject(solver, row, cons, &all_terms_dummy);
     if (!subject && all_terms_dummy) {
-        if (near_zero(value(solver, row)))
+        if (near_zero(row_value(solver, row)))
             subject = cons->marker;
         else {
             free_row(&solver->terms, row);
@@ -897,26 +1939,71 @@ static result_e try_addrow(solver_t *solver, symbol_t row, const constraint_data
     return result_e::OK;
 }
 
-static void delta_edit_constant(solver_t *solver, num_t delta, constraint_handle_t cons_id) {
-    auto cons = constraint_data(solver, cons_id);
+/**
+ * Add constraint row keeping the tableau feasible, objective is left for the caller to optimize
+ */
+static result_e add_row_no_optimize(solver_t *solver, const constraint_desc_t* desc, constraint_handle_t *out_cons) {
+    constraint_data_t cons_data = {};
+    cons_data.relation = desc->relation;
+    cons_data.strength = desc->strength;
+    cons_data.constant = desc->constant;
 
-    auto row_term = find_existing_term(&solver->terms, {cons->marker, 0u});
-    if (row_term) { 
-        row_term->multiplier -= delta; 
-        mark_infeasible(solver, row_term); 
-        return; 
+    if (is_native_bound(solver, desc)) {
+        add_native_bound(solver, desc, &cons_data);
+        *out_cons = array_add(&solver->allocator, solver->constraints, cons_data);
+        add_constraint_refs(solver, *out_cons, desc);
+        return result_e::OK;
+    }
+
+    int alias_index = alias_term_index(solver, desc);
+    if (alias_index >= 0) {
+        add_alias(solver, desc, alias_index, &cons_data);
+        *out_cons = array_add(&solver->allocator, solver->constraints, cons_data);
+        add_constraint_refs(solver, *out_cons, desc);
+        return result_e::OK;
+    }
+
+    symbol_t row = make_row(solver, desc, &cons_data);
+    result_e ret = try_addrow(solver, row, &cons_data);
+    if (ret != result_e::OK) {
+        // todo: test this path
+        remove_errors(solver, &cons_data);
+        delete_variable(solver, cons_data.marker);
+        delete_variable(solver, cons_data.other);
+
+        return ret;
     }
 
-    // cons->other always not null for edit var constraint
-    row_term = find_existing_term(&solver->terms, {cons->other, 0u});
+    *out_cons = array_add(&solver->allocator, solver->constraints, cons_data);
+    add_constraint_refs(solver, *out_cons, desc);
+    return ret;
+}
+
+/**
+ * Coefficient of marker symbol within constraint row made by make_row (before the row sign normalization)
+ */
+static num_t marker_coefficient(const constraint_data_t *cons) {
+    if (cons->relation == relation_e::LESSEQUAL) return 1.0f;
+    if (cons->relation == relation_e::GREATEQUAL) return -1.0f;
+    return cons->strength >= STRENGTH_REQUIRED ? 1.0f : -1.0f;
+}
+
+/**
+ * Rebase symbol as sym = new sym + delta, changed restricted rows are queued as infeasible
+ */
+static void shift_symbol(solver_t *solver, symbol_t sym, num_t delta) {
+    auto row_term = find_existing_term(&solver->terms, {sym, 0u});
     if (row_term) { 
-        row_term->multiplier += delta; 
-        mark_infeasible(solver, row_term); 
+        row_term->multiplier -= delta; 
+        term_changed(&solver->allocator, &solver->terms, row_term);
+        if (!is_external(solver, sym)) {
+            mark_infeasible(solver, row_term); 
+        }
         return; 
     }
 
-    // marker symbol const iteration
-    for (auto sym_iter = first_symbol_iterator(&solver->terms, cons->marker); 
+    // symbol const iteration
+    for (auto sym_iter = first_symbol_iterator(&solver->terms, sym); 
             sym_iter.term_res.term; 
             sym_iter = next_symbol_iterator(&solver->terms, sym_iter) ) {
 
@@ -926,64 +2013,652 @@ static void delta_edit_constant(solver_t *solver, num_t delta, constraint_handle
         auto row_const_term = get_term(&solver->terms, {it_row, 0u});
 
         row_const_term->multiplier += term_multiplier * delta;
+        term_changed(&solver->allocator, &solver->terms, row_const_term);
         if (!is_external(solver, it_row)) {
             mark_infeasible(solver, row_const_term);
         }
     }
 }
 
-static void dual_optimize(solver_t *solver) {
-    while (solver->infeasible_rows != 0) {
-        symbol_t cur, enter = 0u, leave;
-        num_t r, min_ratio = NUM_MAX;
-        symbol_t row = solver->infeasible_rows;
-
-        auto row_const_term = get_term(&solver->terms, {row, 0u});
-
-        leave = row;
-        solver->infeasible_rows = row_const_term->next_row != row ? row_const_term->next_row : 0u;
-        row_const_term->next_row = 0u;
+/**
+ * Shift constraint constant by delta, changed rows are queued as infeasible for dual_optimize
+ * constant change is the same as marker symbol shift by -delta / marker coefficient 
+ * (row sign normalization applies to both and cancels out)
+ */
+static void delta_constant(solver_t *solver, num_t delta, constraint_handle_t cons_id) {
+    auto cons = constraint_data(solver, cons_id);
+    // disabled required constraint has no row, the constant is used when the row is remade
+    if (!cons->marker) return;
 
-        if (near_zero(row_const_term->multiplier) || 
-                row_const_term->multiplier >= 0.0f) 
-            continue;
+    if (cons->bound) {
+        // bound is the variable offset, x = offset + scale * symbol
+        symbol_t var = cons->marker;
+        auto var_data = get_var_data(solver, var);
+        num_t offset_delta = delta / array_get(solver->refs, cons->first_ref).multiplier;
+        num_t symbol_delta = offset_delta / var_data->scale;
+        var_data->offset += offset_delta;
+        shift_symbol(solver, var, symbol_delta);
+        // keep tracked previous value in the new offset terms
+        rebase_value_change(&solver->allocator, &solver->terms, var, -symbol_delta);
+        return;
+    }
 
-        for (auto term_it = first_row_term_iterator(&solver->terms, row);
-                term_it.term_res.term;
-                term_it = next_row_iterator(&solver->terms, term_it)) {
-            auto term_ptr = term_it.term_res.term;
+    const num_t marker_delta = -delta / marker_coefficient(cons);
 
-            cur = term_ptr->pos.column;
-            if (is_dummy(solver, cur) || term_ptr->multiplier <= 0.0f)
-                continue;
-            auto objterm = find_existing_term(&solver->terms, {solver->objective, cur});
-            r = objterm ? objterm->multiplier / term_ptr->multiplier : 0.0f;
-            if (min_ratio > r) min_ratio = r, enter = cur;
-        }
-        assert(enter != 0);
-        pivot(solver, leave, enter, leave);
+    if (cons->alias) {
+        // implicit variable row constant moves along with the marker
+        num_t prev_value = prev_variable_value(solver, cons->alias);
+        auto var_data = get_var_data(solver, cons->alias);
+        var_data->offset += var_data->marker_scale * marker_delta;
+        retrack_value_change(solver, cons->alias, prev_value);
     }
-}
 
-static allocated_chunk_t default_allocate(void *ud, size_t size) {
-    const uint32_t PAGE_SIZE = 4096; // todo: use value from solver desc
-    if (PAGE_SIZE < size) {
-        auto remaining = size % PAGE_SIZE;
-        size = remaining ? (size / PAGE_SIZE + 1) * PAGE_SIZE : size;
+    // other symbol has the opposite marker coefficient
+    auto row_term = (cons->other && !has_row(&solver->terms, cons->marker)) ? 
+        find_existing_term(&solver->terms, {cons->other, 0u}) : nullptr;
+    if (row_term) { 
+        row_term->multiplier += marker_delta; 
+        term_changed(&solver->allocator, &solver->terms, row_term);
+        mark_infeasible(solver, row_term); 
+        return; 
     }
-    return {malloc(size), size};
-}
 
-static void default_free(void *ud, void* p) {
-    ::free(p);
+    shift_symbol(solver, cons->marker, marker_delta);
 }
 
-static const allocator_t s_default_allocator = {
-    default_allocate,
+/**
+ * Row constant change per unit of constraint constant change, the rows are the ones delta_constant updates
+ */
+static num_t constant_row_slope(solver_t *solver, const constraint_data_t *cons, symbol_t row) {
+    const num_t marker_slope = -1.0f / marker_coefficient(cons);
+    if (has_row(&solver->terms, cons->marker)) return row == cons->marker ? -marker_slope : 0.0f;
+    if (cons->other && has_row(&solver->terms, cons->other)) return row == cons->other ? marker_slope : 0.0f;
+
+    auto term = find_existing_term(&solver->terms, {row, cons->marker});
+    return term ? term->multiplier * marker_slope : 0.0f;
+}
+
+/**
+ * Narrow constant delta range to keep restricted row non-negative
+ */
+static void narrow_constant_range(solver_t *solver, symbol_t row, num_t slope, num_t* min_delta, num_t* max_delta) {
+    if (is_external(solver, row) || near_zero(slope)) return;
+
+    num_t bound = -row_value(solver, row) / slope;
+    if (slope > 0.0f) {
+        if (bound > *min_delta) *min_delta = bound;
+    } else {
+        if (bound < *max_delta) *max_delta = bound;
+    }
+}
+
+static void clear_infeasible_rows(solver_t *solver) {
+    while (uint32_t component = solver->infeasible_components) {
+        auto comp = component_data(solver, component);
+        while (symbol_t row = comp->infeasible_rows) {
+            auto row_const_term = get_term(&solver->terms, {row, 0u});
+            comp->infeasible_rows = row_const_term->next_row != row ? row_const_term->next_row : 0u;
+            row_const_term->next_row = 0u;
+        }
+        solver->infeasible_components = comp->next_infeasible != component ? comp->next_infeasible : 0u;
+        comp->next_infeasible = 0u;
+    }
+}
+
+/**
+ * Queue every restricted row with negative value, full scan of dense values
+ */
+static void mark_infeasible_rows(solver_t *solver) {
+    auto row_values = &solver->terms.row_values;
+    for (uint32_t row = 1; row < array_size(row_values); ++row) {
+        if (array_get(*row_values, row) < 0.0f && !is_external(solver, (symbol_t)row)) {
+            mark_infeasible(solver, (symbol_t)row);
+        }
+    }
+}
+
+/**
+ * @return UNSATISFIED if infeasible row has no entering symbol, that is required constraints conflict, 
+ * the row and the rest of the infeasible list are left as is
+ * @return PARTIAL if max_pivots pivots are done, the rest of the infeasible list is left for the next call 
+ * (rows are dual feasible, the objective stays optimal in between)
+ * @param out_pivot_count optional number of pivots done
+ */
+static result_e dual_optimize(solver_t *solver, uint32_t max_pivots = UINT32_MAX, uint32_t* out_pivot_count = nullptr) {
+    uint32_t pivot_count = 0u;
+    result_e res = result_e::OK;
+    // components are resolved one by one, pivots mark rows of the same component only
+    while (uint32_t component = solver->infeasible_components) {
+        auto comp = component_data(solver, component);
+        if (!comp->infeasible_rows) {
+            solver->infeasible_components = comp->next_infeasible != component ? comp->next_infeasible : 0u;
+            comp->next_infeasible = 0u;
+            continue;
+        }
+
+        if (pivot_count == max_pivots) {
+            res = result_e::PARTIAL;
+            break;
+        }
+
+        symbol_t cur, enter = 0u, leave;
+        num_t r, min_ratio = NUM_MAX;
+        symbol_t row = comp->infeasible_rows;
+
+        auto row_const_term = get_term(&solver->terms, {row, 0u});
+
+        leave = row;
+        comp->infeasible_rows = row_const_term->next_row != row ? row_const_term->next_row : 0u;
+        row_const_term->next_row = 0u;
+
+        if (near_zero(row_const_term->multiplier) || 
+                row_const_term->multiplier >= 0.0f) 
+            continue;
+
+        for (auto term_it = first_row_term_iterator(&solver->terms, row);
+                term_it.term_res.term;
+                term_it = next_row_iterator(&solver->terms, term_it)) {
+            auto term_ptr = term_it.term_res.term;
+
+            cur = term_ptr->pos.column;
+            if (is_dummy(solver, cur) || term_ptr->multiplier <= 0.0f)
+                continue;
+            r = dense_row_multiplier(&solver->terms, cur) / term_ptr->multiplier;
+            if (min_ratio > r) min_ratio = r, enter = cur;
+        }
+        if (enter == 0) {
+            clear_infeasible_rows(solver);
+            res = result_e::UNSATISFIED;
+            break;
+        }
+        pivot(solver, leave, enter, leave);
+        ++pivot_count;
+    }
+    if (out_pivot_count) *out_pivot_count = pivot_count;
+    return res;
+}
+
+/**
+ * Resolve rows left by a budgeted suggest, changes other than suggest expect feasible rows
+ */
+static void finish_solve(solver_t *solver) {
+    auto res = dual_optimize(solver);
+    assert(res == result_e::OK && "edit constraints are never required");
+    (void)res;
+}
+
+/**
+ * Drop cached bases, solver changes other than suggest make them stale
+ */
+static void clear_basis_cache(solver_t *solver) {
+    auto cache = solver->basis_cache;
+    if (!cache) return;
+
+    cache->count = 0u;
+    cache->next = 0u;
+    cache->current = 0u;
+}
+
+/**
+ * Restrict bound variable symbol again, negative symbol row is resolved by dual simplex
+ */
+static result_e restore_native_bound(solver_t *solver, constraint_data_t* cons) {
+    symbol_t var = cons->marker;
+    get_var_data(solver, var)->restricted = true;
+    if (has_row(&solver->terms, var)) mark_infeasible(solver, var);
+
+    result_e ret = dual_optimize(solver);
+    if (ret != result_e::OK) {
+        get_var_data(solver, var)->restricted = false;
+        mark_infeasible_rows(solver);
+        auto res = dual_optimize(solver);
+        assert(res == result_e::OK);
+        (void)res;
+    }
+    return ret;
+}
+
+static void disable_constraint(solver_t *solver, constraint_handle_t cons) {
+    auto cons_data = constraint_data(solver, cons);
+    if (cons_data->bound) {
+        remove_native_bound(solver, cons_data);
+    } else if (cons_data->strength >= STRENGTH_REQUIRED) {
+        // required row can't be relaxed, it is remade out of the constraint refs on enable
+        remove_vars(solver, cons);
+    } else {
+        // relax to zero strength, the row stays in the tableau
+        remove_errors(solver, cons_data);
+    }
+    cons_data->disabled = true;
+}
+
+static result_e enable_constraint(solver_t *solver, constraint_handle_t cons) {
+    auto cons_data = constraint_data(solver, cons);
+    if (cons_data->strength < STRENGTH_REQUIRED) {
+        add_errors(solver, cons_data);
+        cons_data->disabled = false;
+        return result_e::OK;
+    }
+
+    if (cons_data->bound) {
+        result_e ret = restore_native_bound(solver, cons_data);
+        if (ret == result_e::OK) cons_data->disabled = false;
+        return ret;
+    }
+
+    uint32_t component = 0u;
+    for (uint32_t ref_index = cons_data->first_ref; ref_index; ) {
+        const auto& ref = array_get(solver->refs, ref_index);
+        component = join_variable(solver, component, ref.var);
+        ref_index = ref.next_cons_ref;
+    }
+    if (!component) component = new_component(solver);
+
+    symbol_t row = new_symbol(solver, symbol_type_e::SLACK, component);
+    init_row(&solver->allocator, &solver->terms, row, -cons_data->constant);
+    for (uint32_t ref_index = cons_data->first_ref; ref_index; ) {
+        const auto& ref = array_get(solver->refs, ref_index);
+        merge_var(solver, row, ref.var, ref.multiplier);
+        ref_index = ref.next_cons_ref;
+    }
+    add_row_markers(solver, row, cons_data);
+
+    result_e ret = try_addrow(solver, row, cons_data);
+    if (ret != result_e::OK) {
+        delete_variable(solver, cons_data->marker);
+        cons_data->marker = 0u;
+        return ret;
+    }
+    cons_data->disabled = false;
+    return ret;
+}
+
+static allocated_chunk_t default_allocate(void *ud, size_t size) {
+    const uint32_t PAGE_SIZE = 4096; // todo: use value from solver desc
+    if (PAGE_SIZE < size) {
+        auto remaining = size % PAGE_SIZE;
+        size = remaining ? (size / PAGE_SIZE + 1) * PAGE_SIZE : size;
+    }
+    return {malloc(size), size};
+}
+
+static void default_free(void *ud, void* p) {
+    ::free(p);
+}
+
+static const allocator_t s_default_allocator = {
+    default_allocate,
     default_free,
     nullptr
 };
 
+/* solver image */
+
+const uint32_t IMAGE_MAGIC = 0x414b4b54u; // "TKKA"
+const uint32_t IMAGE_VERSION = 3u;
+const uint32_t IMAGE_CHECKSUM_SEED = 0x811c9dc5u;
+
+#if defined(TOKOEKA_INDEX_POLICY_ROBIN_HOOD)
+const uint32_t IMAGE_INDEX_POLICY = 1u;
+#elif defined(TOKOEKA_INDEX_POLICY_GROUP)
+const uint32_t IMAGE_INDEX_POLICY = 2u;
+#else
+const uint32_t IMAGE_INDEX_POLICY = 0u;
+#endif
+
+/**
+ * Image is a header followed by arrays of solver records, 
+ * records refer each other by indices only, so the image is position independent, 
+ * but it is bound to the record layout of the build (see layout fields)
+ */
+struct image_header_t {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t record_layout; // var, constraint, ref and term record sizes
+    uint32_t index_layout;  // index policy, dense row entry and component record sizes
+    uint32_t size;          // image byte size
+    uint32_t checksum;      // image bytes with zero checksum field
+
+    uint32_t mapped_var_count;
+    uint32_t infeasible_components;
+    uint32_t dense_row_negative_count;
+    uint32_t value_change_count;
+
+    uint32_t index_size, index_count;
+    uint32_t index_prev_size, index_prev_count;
+    uint32_t index_migrate_start, index_migrated;
+};
+
+static uint32_t image_record_layout() {
+    return (uint32_t)sizeof(var_data_t) | (uint32_t)sizeof(constraint_data_t) << 8 | 
+        (uint32_t)sizeof(constraint_ref_t) << 16 | (uint32_t)sizeof(term_data_t) << 24;
+}
+
+static uint32_t image_index_layout() {
+    return IMAGE_INDEX_POLICY | (uint32_t)sizeof(dense_row_entry_t) << 8 | (uint32_t)sizeof(num_t) << 16 | 
+        (uint32_t)sizeof(component_data_t) << 24;
+}
+
+/**
+ * Hash of image bytes, corrupted images are rejected by it, 
+ * FNV-1a steps by 64 bit words in 4 independent lanes keep it close to memory speed
+ */
+static uint32_t image_checksum(uint32_t seed, const uint8_t* data, size_t size) {
+    const uint64_t prime = 1099511628211ull;
+    uint64_t lanes[4] = {seed, seed + 1u, seed + 2u, seed + 3u};
+
+    size_t offset = 0;
+    for (; offset + sizeof(lanes) <= size; offset += sizeof(lanes)) {
+        uint64_t words[4];
+        memcpy(words, data + offset, sizeof(words));
+        for (uint32_t i = 0; i < 4; ++i) {
+            lanes[i] = (lanes[i] ^ words[i]) * prime;
+        }
+    }
+    for (; offset < size; ++offset) {
+        lanes[0] = (lanes[0] ^ data[offset]) * prime;
+    }
+
+    uint64_t hash = lanes[0];
+    for (uint32_t i = 1; i < 4; ++i) {
+        hash = (hash ^ lanes[i]) * prime;
+    }
+    return (uint32_t)(hash ^ (hash >> 32));
+}
+
+/**
+ * Writes past capacity are counted only, so the image size is known after the first pass
+ */
+struct image_writer_t {
+    uint8_t* data;
+    size_t   capacity;
+    size_t   size;
+};
+
+static void write_bytes(image_writer_t* writer, const void* src, size_t size) {
+    if (writer->size + size <= writer->capacity) memcpy(writer->data + writer->size, src, size);
+    writer->size += size;
+}
+
+/**
+ * Array is written as its size, count of the used elements and the elements
+ */
+template<typename T>
+static void write_array(image_writer_t* writer, const array_t<T>* arr, size_t count) {
+    uint32_t sizes[2] = {(uint32_t)array_size(arr), (uint32_t)count};
+    write_bytes(writer, sizes, sizeof(sizes));
+    write_bytes(writer, arr->entries, count * sizeof(T));
+}
+
+static void write_image(image_writer_t* writer, const solver_t* solver) {
+    auto terms = &solver->terms;
+    auto indices = &terms->indices;
+
+    // padding is zeroed as well, same solver makes the same image
+    image_header_t header;
+    memset(&header, 0, sizeof(header));
+    header.magic = IMAGE_MAGIC;
+    header.version = IMAGE_VERSION;
+    header.record_layout = image_record_layout();
+    header.index_layout = image_index_layout();
+    header.mapped_var_count = solver->mapped_var_count;
+    header.infeasible_components = solver->infeasible_components;
+    header.dense_row_negative_count = terms->dense_row.negative_count;
+    header.value_change_count = terms->value_change_count;
+    header.index_size = indices->slots.size;
+    header.index_count = indices->slots.count;
+    if (index_ht::is_migrating(*indices)) {
+        header.index_prev_size = indices->prev_slots.size;
+        header.index_prev_count = indices->prev_slots.count;
+    }
+    header.index_migrate_start = indices->migrate_start;
+    header.index_migrated = indices->migrated;
+
+    // size is patched once the rest is written
+    size_t header_offset = writer->size;
+    write_bytes(writer, &header, sizeof(header));
+
+    write_array(writer, &solver->vars.array, solver->vars.first_unused_index);
+    write_array(writer, &solver->constraints.array, solver->constraints.first_unused_index);
+    write_array(writer, &solver->refs.array, solver->refs.first_unused_index);
+    write_array(writer, &solver->components.array, solver->components.first_unused_index);
+    write_array(writer, &terms->terms.array, terms->terms.first_unused_index);
+
+    write_bytes(writer, indices->slots.hashes, index_ht::buffer_size(header.index_size));
+    if (header.index_prev_size) {
+        write_bytes(writer, indices->prev_slots.hashes, index_ht::buffer_size(header.index_prev_size));
+    }
+
+    // row scratch is valid for the current stamp only, its size is enough
+    write_array(writer, &terms->row_scratch, 0u);
+    write_array(writer, &terms->dense_row.entries, array_size(&terms->dense_row.entries));
+    write_array(writer, &terms->row_values, array_size(&terms->row_values));
+    write_array(writer, &terms->value_changes, terms->value_change_count);
+    write_array(writer, &terms->value_change_positions, array_size(&terms->value_change_positions));
+
+    header.size = (uint32_t)(writer->size - header_offset);
+    if (writer->size > writer->capacity) return;
+
+    header.checksum = image_checksum(IMAGE_CHECKSUM_SEED, (const uint8_t*)&header, sizeof(header));
+    header.checksum = image_checksum(header.checksum, 
+        writer->data + header_offset + sizeof(header), header.size - sizeof(header));
+    memcpy(writer->data + header_offset, &header, sizeof(header));
+}
+
+struct image_reader_t {
+    const uint8_t* data;
+    size_t         size;
+    size_t         offset;
+    bool           failed;
+};
+
+static const uint8_t* read_bytes(image_reader_t* reader, void* dst, size_t size) {
+    if (reader->failed || reader->size - reader->offset < size) {
+        reader->failed = true;
+        return nullptr;
+    }
+    const uint8_t* src = reader->data + reader->offset;
+    if (dst) memcpy(dst, src, size);
+    reader->offset += size;
+    return src;
+}
+
+/**
+ * Array elements within image
+ */
+struct image_array_t {
+    uint32_t       size;
+    uint32_t       count;
+    const uint8_t* entries;
+};
+
+template<typename T>
+static image_array_t read_array(image_reader_t* reader) {
+    image_array_t res = {};
+    uint32_t sizes[2] = {};
+    read_bytes(reader, sizes, sizeof(sizes));
+    if (!sizes[0] || sizes[1] > sizes[0]) reader->failed = true;
+    if (reader->failed) return res;
+
+    res.size = sizes[0];
+    res.count = sizes[1];
+    res.entries = read_bytes(reader, nullptr, res.count * sizeof(T));
+    return res;
+}
+
+template<typename T>
+static void load_array(allocator_t* alloc, array_t<T>* arr, const image_array_t& image_arr) {
+    array_grow(alloc, arr, image_arr.size);
+    memcpy(arr->entries, image_arr.entries, image_arr.count * sizeof(T));
+    memset(arr->entries + image_arr.count, 0, (array_size(arr) - image_arr.count) * sizeof(T));
+}
+
+template<typename T>
+static void load_array(allocator_t* alloc, sparse_array_t<T>& arr, const image_array_t& image_arr) {
+    load_array(alloc, &arr.array, image_arr);
+    arr.first_unused_index = image_arr.count;
+}
+
+/**
+ * Mark free list elements, the list is expected within used elements and without cycles
+ */
+template<typename T>
+static bool mark_free_entries(sparse_array_t<T>& arr, array_t<uint8_t>* free_marks) {
+    memset(free_marks->entries, 0, array_size(free_marks));
+    uint32_t free_count = 0u;
+    for (uint32_t i = array_get(arr.array, FREELIST_INDEX).next; i; i = array_get(arr.array, i).next) {
+        if (i >= arr.first_unused_index || ++free_count >= arr.first_unused_index) return false;
+        array_get(*free_marks, i) = 1u;
+    }
+    return true;
+}
+
+/**
+ * Symbol, constraint, ref and term indices of the loaded image are within the used elements, 
+ * so a consistent image with out of range records (checksum is not a guard against crafted ones) is rejected
+ */
+static bool image_ranges_valid(solver_t *solver) {
+    const uint32_t var_count = solver->vars.first_unused_index;
+    const uint32_t constraint_count = solver->constraints.first_unused_index;
+    const uint32_t ref_count = solver->refs.first_unused_index;
+    const uint32_t component_count = solver->components.first_unused_index;
+    const uint32_t term_count = solver->terms.terms.first_unused_index;
+    auto terms = &solver->terms;
+
+    if (!var_count || var_count > 0x10000u || !constraint_count || !ref_count || !component_count || !term_count) 
+        return false;
+    if (!index_ht::values_in_range(terms->indices, term_count)) return false;
+    if (solver->infeasible_components >= component_count) return false;
+
+    uint32_t max_count = var_count;
+    if (constraint_count > max_count) max_count = constraint_count;
+    if (ref_count > max_count) max_count = ref_count;
+    if (component_count > max_count) max_count = component_count;
+    if (term_count > max_count) max_count = term_count;
+    array_t<uint8_t> free_marks = {};
+    array_grow(&solver->allocator, &free_marks, max_count);
+
+    uint32_t member_count = 0u;
+    bool valid = mark_free_entries(solver->vars, &free_marks);
+    for (uint32_t i = 1; valid && i < var_count; ++i) {
+        if (array_get(free_marks, i)) continue;
+        const auto& var_data = array_get(solver->vars, i);
+        valid = var_data.type <= symbol_type_e::DUMMY &&
+            var_data.constraint < constraint_count && var_data.first_ref < ref_count &&
+            var_data.alias < var_count && var_data.alias_marker < var_count && 
+            var_data.first_alias < var_count && var_data.next_alias < var_count &&
+            var_data.component < component_count && 
+            var_data.prev_member < var_count && var_data.next_member < var_count;
+        if (var_data.component) ++member_count;
+    }
+
+    // member lists link symbols of their component back, so every member is in the list of a used component
+    valid = valid && mark_free_entries(solver->components, &free_marks);
+    for (uint32_t i = 1; valid && i < component_count; ++i) {
+        if (array_get(free_marks, i)) continue;
+        const auto& comp = array_get(solver->components, i);
+        valid = comp.objective && comp.objective < var_count && 
+            array_get(solver->vars, comp.objective).component == i &&
+            comp.infeasible_rows < var_count && comp.next_infeasible < component_count &&
+            comp.member_count <= member_count;
+        uint32_t count = 0u;
+        for (symbol_t sym = comp.first_member, prev = 0u; valid && sym; ) {
+            valid = sym < var_count && ++count <= comp.member_count;
+            if (!valid) break;
+            const auto& var_data = array_get(solver->vars, sym);
+            valid = var_data.component == i && var_data.prev_member == prev;
+            prev = sym;
+            sym = var_data.next_member;
+        }
+        valid = valid && count == comp.member_count;
+        member_count -= valid ? count : 0u;
+    }
+    valid = valid && !member_count;
+
+    valid = valid && mark_free_entries(solver->constraints, &free_marks);
+    for (uint32_t i = 1; valid && i < constraint_count; ++i) {
+        if (array_get(free_marks, i)) continue;
+        const auto& cons_data = array_get(solver->constraints, i);
+        valid = cons_data.marker < var_count && cons_data.other < var_count && 
+            cons_data.alias < var_count && cons_data.first_ref < ref_count;
+    }
+
+    valid = valid && mark_free_entries(solver->refs, &free_marks);
+    for (uint32_t i = 1; valid && i < ref_count; ++i) {
+        if (array_get(free_marks, i)) continue;
+        const auto& ref = array_get(solver->refs, i);
+        valid = ref.constraint < constraint_count && ref.var < var_count && 
+            ref.prev_var_ref < ref_count && ref.next_var_ref < ref_count && ref.next_cons_ref < ref_count;
+    }
+
+    // every used term is found by its coordinates at its own index and 
+    // is linked to used terms of the same lists linking it back, so list iteration gets back to the head
+    uint32_t used_term_count = 0u;
+    valid = valid && mark_free_entries(terms->terms, &free_marks);
+    for (uint32_t i = 1; valid && i < term_count; ++i) {
+        if (array_get(free_marks, i)) continue;
+        const auto& term = array_get(terms->terms, i);
+        valid = term.pos.row < var_count && term.pos.column < var_count &&
+            term.prev_row < term_count && term.prev_column < term_count && term.next_column < term_count;
+        if (!valid) break;
+
+        auto index_res = get_term_index_no_assert(terms, term.pos);
+        valid = index_res.found && index_res.index == i;
+        ++used_term_count;
+
+        if (term.pos.column) {
+            // symbol list
+            valid = valid && term.next_row < term_count && term.next_row && !array_get(free_marks, term.next_row);
+            valid = valid && array_get(terms->terms, term.next_row).pos.column == term.pos.column && 
+                array_get(terms->terms, term.next_row).prev_row == i;
+        } else {
+            // row constant term links infeasible rows by symbol
+            valid = valid && term.next_row < var_count;
+        }
+        if (term.pos.row) {
+            // row list
+            valid = valid && term.next_column && !array_get(free_marks, term.next_column);
+            valid = valid && array_get(terms->terms, term.next_column).pos.row == term.pos.row && 
+                array_get(terms->terms, term.next_column).prev_column == i;
+        }
+    }
+    valid = valid && used_term_count == index_ht::count(terms->indices);
+    free_array(&solver->allocator, &free_marks);
+
+    // infeasible component and row lists end with an element linking itself
+    uint32_t infeasible_count = 0u, component_queue_count = 0u;
+    for (uint32_t component = solver->infeasible_components; valid && component; ) {
+        const auto& comp = array_get(solver->components, component);
+        valid = comp.objective < var_count && array_get(solver->vars, comp.objective).component == component &&
+            comp.next_infeasible && ++component_queue_count < component_count;
+        for (symbol_t row = comp.infeasible_rows; valid && row; ) {
+            auto row_term = find_existing_term(terms, {row, 0u});
+            valid = row_term && array_get(solver->vars, row).component == component && ++infeasible_count < var_count;
+            if (!valid || row_term->next_row == row) break;
+            row = (symbol_t)row_term->next_row;
+        }
+        if (!valid || comp.next_infeasible == component) break;
+        component = comp.next_infeasible;
+    }
+
+    // dense rows are indexed by symbol with size checks, stored symbols and positions are checked only
+    auto& dense_row = terms->dense_row;
+    valid = valid && dense_row.negative_count <= array_size(&dense_row.entries);
+    for (uint32_t i = 0; valid && i < array_size(&dense_row.entries); ++i) {
+        const auto& entry = array_get(dense_row.entries, i);
+        valid = entry.negative_index <= dense_row.negative_count && 
+            (i >= dense_row.negative_count || entry.negative_column < var_count);
+    }
+    valid = valid && terms->value_change_count <= array_size(&terms->value_changes);
+    for (uint32_t i = 0; valid && i < terms->value_change_count; ++i) {
+        valid = array_get(terms->value_changes, i).symbol < array_size(&terms->value_change_positions);
+    }
+    for (uint32_t i = 0; valid && i < array_size(&terms->value_change_positions); ++i) {
+        valid = array_get(terms->value_change_positions, i) <= terms->value_change_count;
+    }
+    return valid;
+}
+
 } // internal namespace
 
 /**
@@ -1007,86 +2682,408 @@ solver_t *create_solver(const solver_desc_t* desc) {
     assert(!(PAGE_SIZE & (PAGE_SIZE - 1)) && "expect power of 2 size");
     array_init(&solver->allocator, solver->vars, PAGE_SIZE);
     array_init(&solver->allocator, solver->constraints, PAGE_SIZE);
+    array_init(&solver->allocator, solver->refs, PAGE_SIZE);
+    // objective rows are created along with components
+    array_init(&solver->allocator, solver->components, PAGE_SIZE);
 
     init_table(&solver->allocator, &solver->terms, PAGE_SIZE);
-    
-    // init objective function
-    solver->objective = new_symbol(solver, symbol_type_e::EXTERNAL);
-    init_row(&solver->allocator, &solver->terms, solver->objective, 0.0f);
 
     return solver;
 }
 
+static void destroy_basis_cache(solver_t *solver) {
+    auto cache = solver->basis_cache;
+    if (!cache) return;
+
+    auto alloc = &solver->allocator;
+    for (uint32_t i = 0; i < cache->capacity; ++i) {
+        if (auto snapshot = array_get(cache->snapshots, i)) destroy_solver(snapshot);
+    }
+    free_array(alloc, &cache->snapshots);
+    // the rest is grown by the first store
+    if (cache->edit_vars.entries) free_array(alloc, &cache->edit_vars);
+    if (cache->edit_positions.entries) free_array(alloc, &cache->edit_positions);
+    if (cache->boxes.entries) free_array(alloc, &cache->boxes);
+    if (cache->targets.entries) free_array(alloc, &cache->targets);
+    if (cache->saved_values.entries) free_array(alloc, &cache->saved_values);
+    if (cache->saved_changes.entries) free_array(alloc, &cache->saved_changes);
+
+    free(alloc, cache);
+    solver->basis_cache = nullptr;
+}
+
 void destroy_solver(solver_t *solver) {
     assert(solver);
 
+    destroy_basis_cache(solver);
     free_array(&solver->allocator, solver->vars);
     free_array(&solver->allocator, solver->constraints);
+    free_array(&solver->allocator, solver->refs);
+    free_array(&solver->allocator, solver->components);
     free_table(&solver->allocator, &solver->terms);
 
     free(&solver->allocator, solver);
 }
 
+/**
+ * Copy solver buffers with destination allocator
+ */
+static void copy_solver(solver_t *dst, const solver_t *src) {
+    array_copy(&dst->allocator, dst->vars, src->vars);
+    array_copy(&dst->allocator, dst->constraints, src->constraints);
+    array_copy(&dst->allocator, dst->refs, src->refs);
+    copy_table(&dst->allocator, &dst->terms, &src->terms);
+
+    array_copy(&dst->allocator, dst->components, src->components);
+
+    dst->mapped_var_count = src->mapped_var_count;
+    dst->infeasible_components = src->infeasible_components;
+}
+
+solver_t *clone_solver(const solver_t *solver) {
+    assert(solver);
+
+    allocator_t allocator = solver->allocator;
+    auto clone_mem = allocate(&allocator, sizeof(solver_t));
+    solver_t* clone = (solver_t*)clone_mem.ptr;
+    memset(clone, 0, sizeof(*clone));
+    clone->allocator = allocator;
+
+    copy_solver(clone, solver);
+    return clone;
+}
+
+void restore_solver(solver_t *solver, const solver_t *snapshot) {
+    assert(solver);
+    assert(snapshot);
+    if (solver == snapshot) return;
+
+    clear_basis_cache(solver);
+    copy_solver(solver, snapshot);
+}
+
+size_t save_solver(const solver_t *solver, void* buffer, size_t capacity) {
+    assert(solver);
+    assert(buffer || !capacity);
+
+    image_writer_t size_writer = {};
+    write_image(&size_writer, solver);
+    if (size_writer.size > capacity) return size_writer.size;
+
+    image_writer_t writer = {};
+    writer.data = (uint8_t*)buffer;
+    writer.capacity = capacity;
+    write_image(&writer, solver);
+    return writer.size;
+}
+
+solver_t *load_solver(const solver_desc_t* desc, const void* image, size_t size) {
+    assert(desc);
+    assert(image || !size);
+
+    // validate the whole image before any allocation
+    image_reader_t reader = {};
+    reader.data = (const uint8_t*)image;
+    reader.size = size;
+
+    image_header_t header = {};
+    read_bytes(&reader, &header, sizeof(header));
+    if (reader.failed ||
+            header.magic != IMAGE_MAGIC || 
+            header.version != IMAGE_VERSION ||
+            header.record_layout != image_record_layout() || 
+            header.index_layout != image_index_layout() ||
+            header.size != size)
+        return nullptr;
+
+    // header is hashed with zero checksum field, then the rest of the image
+    uint32_t checksum = header.checksum;
+    header.checksum = 0u;
+    uint32_t image_hash = image_checksum(IMAGE_CHECKSUM_SEED, (const uint8_t*)&header, sizeof(header));
+    image_hash = image_checksum(image_hash, reader.data + sizeof(header), size - sizeof(header));
+    if (image_hash != checksum) return nullptr;
+
+    image_array_t vars = read_array<sparse_array_t<var_data_t>::entry_t>(&reader);
+    image_array_t constraints = read_array<sparse_array_t<constraint_data_t>::entry_t>(&reader);
+    image_array_t refs = read_array<sparse_array_t<constraint_ref_t>::entry_t>(&reader);
+    image_array_t components = read_array<sparse_array_t<component_data_t>::entry_t>(&reader);
+    image_array_t terms = read_array<sparse_array_t<term_data_t>::entry_t>(&reader);
+
+    const bool index_power_of_2 = header.index_size && !(header.index_size & (header.index_size - 1)) &&
+        !(header.index_prev_size & (header.index_prev_size - 1));
+    const uint8_t* index_slots = index_power_of_2 ? 
+        read_bytes(&reader, nullptr, index_ht::buffer_size(header.index_size)) : nullptr;
+    const uint8_t* index_prev_slots = index_power_of_2 && header.index_prev_size ? 
+        read_bytes(&reader, nullptr, index_ht::buffer_size(header.index_prev_size)) : nullptr;
+
+    image_array_t row_scratch = read_array<row_scratch_entry_t>(&reader);
+    image_array_t dense_row_entries = read_array<dense_row_entry_t>(&reader);
+    image_array_t row_values = read_array<num_t>(&reader);
+    image_array_t value_changes = read_array<value_change_t>(&reader);
+    image_array_t value_change_positions = read_array<uint32_t>(&reader);
+
+    if (reader.failed || 
+            !index_power_of_2 ||
+            reader.offset != size ||
+            header.value_change_count != value_changes.count)
+        return nullptr;
+
+    solver_desc_t solver_desc = *desc;
+    if (!solver_desc.allocator.allocate) {
+        solver_desc.allocator = s_default_allocator;
+    }
+    auto solver_mem = allocate(&solver_desc.allocator, sizeof(solver_t));
+    solver_t* solver = (solver_t*)solver_mem.ptr;
+    memset(solver, 0, sizeof(*solver));
+    solver->allocator = solver_desc.allocator;
+    auto alloc = &solver->allocator;
+
+    load_array(alloc, solver->vars, vars);
+    load_array(alloc, solver->constraints, constraints);
+    load_array(alloc, solver->refs, refs);
+    load_array(alloc, solver->components, components);
+    load_array(alloc, solver->terms.terms, terms);
+
+    auto indices = &solver->terms.indices;
+    indices->slots.size = header.index_size;
+    indices->slots.count = header.index_count;
+    indices->prev_slots.size = header.index_prev_size;
+    indices->prev_slots.count = header.index_prev_count;
+    indices->migrate_start = header.index_migrate_start;
+    indices->migrated = header.index_migrated;
+    void* index_buffer = allocate(alloc, index_ht::buffer_size(header.index_size)).ptr;
+    memcpy(index_buffer, index_slots, index_ht::buffer_size(header.index_size));
+    void* index_prev_buffer = nullptr;
+    if (header.index_prev_size) {
+        index_prev_buffer = allocate(alloc, index_ht::buffer_size(header.index_prev_size)).ptr;
+        memcpy(index_prev_buffer, index_prev_slots, index_ht::buffer_size(header.index_prev_size));
+    }
+    index_ht::rebase(*indices, index_buffer, index_prev_buffer);
+
+    load_array(alloc, &solver->terms.row_scratch, row_scratch);
+    load_array(alloc, &solver->terms.dense_row.entries, dense_row_entries);
+    solver->terms.dense_row.negative_count = header.dense_row_negative_count;
+    load_array(alloc, &solver->terms.row_values, row_values);
+    load_array(alloc, &solver->terms.value_changes, value_changes);
+    load_array(alloc, &solver->terms.value_change_positions, value_change_positions);
+    solver->terms.value_change_count = header.value_change_count;
+
+    solver->mapped_var_count = header.mapped_var_count;
+    solver->infeasible_components = header.infeasible_components;
+
+    if (!image_ranges_valid(solver)) {
+        destroy_solver(solver);
+        return nullptr;
+    }
+    return solver;
+}
+
 symbol_t create_variable(solver_t *solver) {
     assert(solver);
-    return new_symbol(solver, symbol_type_e::EXTERNAL);
+    clear_basis_cache(solver);
+    return new_symbol(solver, symbol_type_e::EXTERNAL, 0u);
+}
+
+symbol_t create_variables(solver_t *solver, uint32_t count) {
+    assert(solver);
+    if (!count) return 0u;
+    clear_basis_cache(solver);
+
+    // symbols are 16 bit
+    if (solver->vars.first_unused_index + count > 0x10000u) return 0u;
+
+    var_data_t data = {};
+    data.type = symbol_type_e::EXTERNAL;
+    data.scale = 1.0f;
+    symbol_t first = (symbol_t)array_add_range(&solver->allocator, solver->vars, count, data);
+
+    // symbol link list heads
+    array_reserve(&solver->allocator, solver->terms.terms, count);
+    for (uint32_t i = 0; i < count; ++i) {
+        add_term(&solver->allocator, &solver->terms, 0u, (symbol_t)(first + i), 0.0f);
+    }
+
+    return first;
 }
 
 void delete_variable(solver_t *solver, symbol_t var) {
     assert(solver);
     if (!var) return;
+    clear_basis_cache(solver);
 
     const auto& var_data = array_get(solver->vars, var); 
     remove_constraint(solver, var_data.constraint);
+    
+    // component is released along with its last symbol but the objective
+    const uint32_t component = var_data.component;
+    if (component) remove_member(solver, var);
 
     // todo: delete rows? 
+    assert(!var_data.first_ref && "variable is used by constraints, see delete_variables");
+    assert(!var_data.alias && !var_data.first_alias);
     assert(!has_row(&solver->terms, var));
     assert(!first_symbol_iterator(&solver->terms, var).term_res.term);
 
+    if (is_mapped(&var_data)) solver->mapped_var_count--;
+    // symbol handle is reused
+    if (var_data.type == symbol_type_e::DUMMY) dense_row_pin(&solver->allocator, &solver->terms, var, false);
+
     // delete symbol link list
     auto term_it = get_term_result(&solver->terms, {0u, var});
     delete_term(&solver->terms, &term_it, unlink_frags_e::NONE);
 
     // link to free list
     array_remove(solver->vars, var);
+
+    if (component && component_data(solver, component)->member_count == 1) release_component(solver, component);
+}
+
+void delete_variables(solver_t *solver, uint32_t count, const symbol_t* vars) {
+    assert(solver);
+    finish_solve(solver);
+    clear_basis_cache(solver);
+    assert(vars || !count);
+
+    bool removed = false;
+    for (uint32_t i = 0; i < count; ++i) {
+        symbol_t var = vars[i];
+        // repeated handle is deleted already, its symbol list head is gone
+        if (!var || !find_existing_term(&solver->terms, {0u, var})) continue;
+
+        // edit constraint is in the refs list as well
+        auto var_data = get_var_data(solver, var);
+        var_data->constraint = 0u;
+        var_data->edit_value = 0.0f;
+
+        // every removal unlinks all the constraint refs, list head moves on
+        while (uint32_t ref_index = get_var_data(solver, var)->first_ref) {
+            remove_constraint_no_optimize(solver, array_get(solver->refs, ref_index).constraint);
+            removed = true;
+        }
+
+        delete_variable(solver, var);
+    }
+
+    // marker pivots keep rows feasible, objective is optimized once for all removals
+    if (removed) {
+        optimize_changed(solver);
+    }
 }
 
 num_t value(solver_t *solver, symbol_t var) {
     assert(solver);
     assert(var);
 
-    const term_coord_t key = {var, 0u};
-    auto var_term = find_existing_term(&solver->terms, key);
-    if (var_term) {
-        return var_term->multiplier;
+    // alias marker is dummy, its value is 0
+    auto var_data = get_var_data(solver, var);
+    num_t symbol_value = var_data->alias ? value(solver, var_data->alias) : row_value(solver, var);
+    return var_data->offset + var_data->scale * symbol_value;
+}
+
+void values(solver_t *solver, symbol_t first, uint32_t count, num_t* out_values) {
+    assert(solver);
+    assert(first || !count);
+    assert((uint32_t)first + count <= (uint32_t)UINT16_MAX + 1u);
+    assert(out_values || !count);
+
+    auto row_values = &solver->terms.row_values;
+    auto size = array_size(row_values);
+    uint32_t mirrored = first < size ? (uint32_t)(size - first) : 0u;
+    if (mirrored > count) mirrored = count;
+
+    if (mirrored) memcpy(out_values, &array_get(*row_values, first), mirrored * sizeof(num_t));
+    // no rows beyond mirrored symbols
+    for (uint32_t i = mirrored; i < count; ++i) {
+        out_values[i] = 0.0f;
     }
 
-    return 0.0f;
+    if (!solver->mapped_var_count) return;
+
+    uint32_t var_count = solver->vars.first_unused_index;
+    for (uint32_t i = 0; i < count && first + i < var_count; ++i) {
+        symbol_t var = (symbol_t)(first + i);
+        auto var_data = get_var_data(solver, var);
+        out_values[i] = var_data->alias ? value(solver, var) : var_data->offset + var_data->scale * out_values[i];
+    }
+}
+
+uint32_t pop_changed_variables(solver_t *solver, symbol_t* out_vars, uint32_t capacity) {
+    assert(solver);
+    assert(out_vars || !capacity);
+
+    auto terms = &solver->terms;
+    uint32_t count = 0u;
+    while (count < capacity && terms->value_change_count) {
+        auto change = array_get(terms->value_changes, terms->value_change_count - 1);
+        untrack_value_change(terms, change.symbol);
+
+        // skip internal symbols and values changed back
+        if (is_objective(solver, change.symbol) || !is_variable(solver, change.symbol)) continue;
+        auto var_data = get_var_data(solver, change.symbol);
+        num_t prev_value = var_data->alias ? change.prev_value : var_data->offset + var_data->scale * change.prev_value;
+        if (prev_value == value(solver, change.symbol)) continue;
+
+        out_vars[count++] = change.symbol;
+
+        // aliased variables move along, they are popped next
+        for (symbol_t alias = var_data->first_alias; alias; alias = get_var_data(solver, alias)->next_alias) {
+            auto alias_data = get_var_data(solver, alias);
+            reserve_value_changes(&solver->allocator, terms, alias);
+            track_value_change(terms, alias, alias_data->offset + alias_data->scale * prev_value);
+        }
+    }
+    return count;
+}
+
+void clear_changed_variables(solver_t *solver) {
+    assert(solver);
+
+    auto terms = &solver->terms;
+    for (uint32_t i = 0; i < terms->value_change_count; ++i) {
+        array_get(terms->value_change_positions, array_get(terms->value_changes, i).symbol) = 0u;
+    }
+    terms->value_change_count = 0u;
 }
 
 result_e add_constraint(solver_t *solver, const constraint_desc_t* desc, constraint_handle_t *out_cons) {
     assert(solver);
+    finish_solve(solver);
+    clear_basis_cache(solver);
     assert(desc);
     assert(out_cons);
 
-    constraint_data_t cons_data = {};
-    cons_data.strength = desc->strength;
-    symbol_t row = make_row(solver, desc, &cons_data);
-    result_e ret = try_addrow(solver, row, &cons_data);
-    if (ret != result_e::OK) {
-        // todo: test this path
-        remove_errors(solver, &cons_data);
-        delete_variable(solver, cons_data.marker);
-        delete_variable(solver, cons_data.other);
+    // failed row can leave artificial pivots behind as well
+    result_e ret = add_row_no_optimize(solver, desc, out_cons);
+    optimize_changed(solver);
 
-        return ret;
-    } else {
-        optimize(solver, solver->objective);
+    assert(solver->infeasible_components == 0);
+    return ret;
+}
+
+result_e add_constraints(solver_t *solver, uint32_t count, const constraint_desc_t* descs, 
+                         constraint_handle_t *out_cons, result_e* out_results) {
+    assert(solver);
+    finish_solve(solver);
+    clear_basis_cache(solver);
+    assert(descs || !count);
+    assert(out_cons || !count);
+
+    result_e ret = result_e::OK;
+    for (uint32_t i = 0; i < count; ++i) {
+        out_cons[i] = 0u;
+        result_e cons_ret = add_row_no_optimize(solver, &descs[i], &out_cons[i]);
+        if (out_results) out_results[i] = cons_ret;
+
+        if (ret == result_e::OK) ret = cons_ret;
     }
 
-    *out_cons = array_add(&solver->allocator, solver->constraints, cons_data);
+    // rows are kept feasible by try_addrow, objective is optimized once for all of them 
+    // (failed rows can leave artificial pivots behind as well)
+    if (count) {
+        optimize_changed(solver);
+    }
 
-    assert(solver->infeasible_rows == 0);
+    assert(solver->infeasible_components == 0);
     return ret;
 }
 
@@ -1094,10 +3091,30 @@ void remove_constraint(solver_t *solver, constraint_handle_t cons) {
     assert(solver);
     if (!cons) return;
 
-    remove_vars(solver, cons);
+    finish_solve(solver);
+    clear_basis_cache(solver);
+    remove_constraint_no_optimize(solver, cons);
+    optimize_changed(solver);
+}
 
-    // link to free list
-    array_remove(solver->constraints, cons);
+void remove_constraints(solver_t *solver, uint32_t count, const constraint_handle_t* cons) {
+    assert(solver);
+    finish_solve(solver);
+    clear_basis_cache(solver);
+    assert(cons || !count);
+
+    bool removed = false;
+    for (uint32_t i = 0; i < count; ++i) {
+        if (!cons[i]) continue;
+
+        remove_constraint_no_optimize(solver, cons[i]);
+        removed = true;
+    }
+
+    // marker pivots keep rows feasible, objective is optimized once for all removals
+    if (removed) {
+        optimize_changed(solver);
+    }
 }
 
 result_e enable_edit(solver_t *solver, symbol_t var, num_t strength) {
@@ -1147,24 +3164,181 @@ bool has_edit(solver_t *solver, symbol_t var) {
     return var_data->constraint; 
 }
 
-void suggest(solver_t *solver, 
-        uint16_t count, const symbol_t* vars, const num_t* values) {
+/**
+ * Collect edit variables of the solver, freed variables keep stale data, so they are told apart by the symbol list head
+ */
+static void collect_edit_vars(solver_t *solver) {
+    auto cache = solver->basis_cache;
+    auto alloc = &solver->allocator;
+
+    for (uint32_t i = 0; i < cache->edit_var_count; ++i) {
+        array_get(cache->edit_positions, array_get(cache->edit_vars, i)) = 0u;
+    }
+    cache->edit_var_count = 0u;
+
+    for (uint32_t var = 1; var < solver->vars.first_unused_index; ++var) {
+        if (!find_existing_term(&solver->terms, {0u, (symbol_t)var})) continue;
+
+        auto var_data = get_var_data(solver, (symbol_t)var);
+        if (var_data->type != symbol_type_e::EXTERNAL || !var_data->constraint) continue;
+
+        array_get_grow(alloc, &cache->edit_vars, cache->edit_var_count) = (symbol_t)var;
+        array_get_grow(alloc, &cache->edit_positions, var) = ++cache->edit_var_count;
+    }
+}
+
+/**
+ * Store solved solver as the current cache entry, the oldest entry is replaced if the cache is full
+ */
+static void store_basis(solver_t *solver) {
+    auto cache = solver->basis_cache;
+    auto alloc = &solver->allocator;
+    if (!cache->count) collect_edit_vars(solver);
+
+    const uint32_t entry = cache->next;
+    cache->next = (entry + 1) % cache->capacity;
+    if (cache->count < cache->capacity) cache->count++;
+
+    auto& snapshot = array_get(cache->snapshots, entry);
+    if (snapshot) {
+        copy_solver(snapshot, solver);
+    } else {
+        snapshot = clone_solver(solver);
+    }
+
+    for (uint32_t i = 0; i < cache->edit_var_count; ++i) {
+        auto& box = array_get_grow(alloc, &cache->boxes, entry * cache->edit_var_count + i);
+        edit_range(solver, array_get(cache->edit_vars, i), &box.min, &box.max);
+    }
+    cache->current = entry + 1;
+}
+
+static bool basis_contains_targets(const basis_cache_t* cache, uint32_t entry) {
+    const edit_box_t* boxes = cache->boxes.entries + entry * cache->edit_var_count;
+    for (uint32_t i = 0; i < cache->edit_var_count; ++i) {
+        num_t target = cache->targets.entries[i];
+        if (target < boxes[i].min || target > boxes[i].max) return false;
+    }
+    return true;
+}
+
+/**
+ * Copy cached basis into the solver, 
+ * changes tracked since the last pop are kept and values moved by the copy are tracked on top of them
+ */
+static void restore_basis(solver_t *solver, const solver_t *snapshot) {
+    auto cache = solver->basis_cache;
+    auto alloc = &solver->allocator;
+    auto terms = &solver->terms;
+
+    array_copy(alloc, &cache->saved_values, &terms->row_values);
+    array_copy(alloc, &cache->saved_changes, &terms->value_changes);
+    const uint32_t saved_change_count = terms->value_change_count;
+
+    copy_solver(solver, snapshot);
+    clear_changed_variables(solver);
+
+    for (uint32_t i = 0; i < saved_change_count; ++i) {
+        auto change = array_get(cache->saved_changes, i);
+        reserve_value_changes(alloc, terms, change.symbol);
+        track_value_change(terms, change.symbol, change.prev_value);
+    }
+
+    // no mirrored value beyond array sizes is 0
+    const size_t saved_size = array_size(&cache->saved_values);
+    const size_t size = array_size(&terms->row_values);
+    for (size_t sym = 1; sym < saved_size || sym < size; ++sym) {
+        num_t prev_value = sym < saved_size ? array_get(cache->saved_values, sym) : 0.0f;
+        num_t value = sym < size ? array_get(terms->row_values, sym) : 0.0f;
+        if (prev_value == value) continue;
+
+        reserve_value_changes(alloc, terms, (symbol_t)sym);
+        track_value_change(terms, (symbol_t)sym, prev_value);
+    }
+}
+
+/**
+ * Jump to a cached basis feasible for suggested values of edit variables (the rest keep their values), 
+ * the basis is taken with edit constants shifted to suggested values
+ * @return false if no cached basis contains the values or the current one does (its shift needs no pivots)
+ */
+static bool restore_cached_basis(solver_t *solver, uint16_t count, const symbol_t* vars, const num_t* values) {
+    auto cache = solver->basis_cache;
+    if (!cache->count) return false;
+
+    auto alloc = &solver->allocator;
+    for (uint32_t i = 0; i < cache->edit_var_count; ++i) {
+        array_get_grow(alloc, &cache->targets, i) = get_var_data(solver, array_get(cache->edit_vars, i))->edit_value;
+    }
     for (uint16_t i = 0u; i < count; ++i) {
-        symbol_t var = vars[i];
-        num_t value = values[i];
+        array_get(cache->targets, array_get(cache->edit_positions, vars[i]) - 1) = values[i];
+    }
 
-        auto var_data = get_var_data(solver, var);
+    if (cache->current && basis_contains_targets(cache, cache->current - 1)) return false;
+
+    for (uint32_t entry = 0; entry < cache->count; ++entry) {
+        if (entry + 1 == cache->current || !basis_contains_targets(cache, entry)) continue;
+
+        restore_basis(solver, array_get(cache->snapshots, entry));
+        cache->current = entry + 1;
 
-        if (var_data->constraint == 0) {
-            enable_edit(solver, var, STRENGTH_MEDIUM);
-            auto var_data = get_var_data(solver, var);
-            assert(var_data->constraint);
+        for (uint32_t i = 0; i < cache->edit_var_count; ++i) {
+            auto var_data = get_var_data(solver, array_get(cache->edit_vars, i));
+            num_t delta = array_get(cache->targets, i) - var_data->edit_value;
+            if (delta == 0.0f) continue;
+
+            var_data->edit_value = array_get(cache->targets, i);
+            delta_constant(solver, delta, var_data->constraint);
         }
-        num_t delta = value - var_data->edit_value;
-        var_data->edit_value = value;
-        delta_edit_constant(solver, delta, var_data->constraint);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Keep the solved basis if pivots moved the solver to it, budgeted solve in progress has no basis to keep
+ */
+static void update_basis_cache(solver_t *solver, result_e res, uint32_t pivot_count) {
+    auto cache = solver->basis_cache;
+    if (res != result_e::OK) {
+        cache->current = 0u;
+        return;
+    }
+    if (pivot_count || !cache->current) store_basis(solver);
+}
+
+result_e suggest(solver_t *solver, 
+        uint16_t count, const symbol_t* vars, const num_t* values, uint32_t max_pivots) {
+    for (uint16_t i = 0u; i < count; ++i) {
+        if (!get_var_data(solver, vars[i])->constraint) {
+            enable_edit(solver, vars[i], STRENGTH_MEDIUM);
+        }
+    }
+    // edit constants are shifted from the cached basis, so the loop below finds them in place
+    if (solver->basis_cache) restore_cached_basis(solver, count, vars, values);
+
+    for (uint16_t i = 0u; i < count; ++i) {
+        auto var_data = get_var_data(solver, vars[i]);
+        assert(var_data->constraint);
+
+        // repeated value keeps the basis and every row as is
+        num_t delta = values[i] - var_data->edit_value;
+        if (delta == 0.0f) continue;
+
+        var_data->edit_value = values[i];
+        delta_constant(solver, delta, var_data->constraint);
     }
-    dual_optimize(solver);
+    // rows left from a previous budgeted call are in the infeasible list as well
+    uint32_t pivot_count = 0u;
+    auto res = dual_optimize(solver, max_pivots, &pivot_count);
+    assert(res != result_e::UNSATISFIED && "edit constraints are never required");
+    if (solver->basis_cache) update_basis_cache(solver, res, pivot_count);
+    return res;
+}
+
+void suggest(solver_t *solver, 
+        uint16_t count, const symbol_t* vars, const num_t* values) {
+    suggest(solver, count, vars, values, UINT32_MAX);
 }
 
 void suggest(solver_t *solver, symbol_t var, num_t value) {
@@ -1173,4 +3347,191 @@ void suggest(solver_t *solver, symbol_t var, num_t value) {
     suggest(solver, 1, vars, values);
 }
 
+result_e continue_solve(solver_t *solver, uint32_t max_pivots) {
+    assert(solver);
+
+    uint32_t pivot_count = 0u;
+    auto res = dual_optimize(solver, max_pivots, &pivot_count);
+    if (solver->basis_cache) update_basis_cache(solver, res, pivot_count);
+    return res;
+}
+
+void set_basis_cache(solver_t *solver, uint32_t capacity) {
+    assert(solver);
+
+    destroy_basis_cache(solver);
+    if (!capacity) return;
+
+    auto alloc = &solver->allocator;
+    auto cache = (basis_cache_t*)allocate(alloc, sizeof(basis_cache_t)).ptr;
+    memset(cache, 0, sizeof(*cache));
+    cache->capacity = capacity;
+    array_grow(alloc, &cache->snapshots, capacity);
+    memset(cache->snapshots.entries, 0, array_size(&cache->snapshots) * sizeof(solver_t*));
+
+    solver->basis_cache = cache;
+}
+
+result_e edit_range(solver_t *solver, symbol_t var, num_t* out_min, num_t* out_max) {
+    assert(solver);
+    assert(out_min && out_max);
+
+    // range is for the solved basis
+    finish_solve(solver);
+
+    auto var_data = get_var_data(solver, var);
+    if (!var_data->constraint) return result_e::FAILED;
+
+    const num_t edit_value = var_data->edit_value;
+    auto cons = constraint_data(solver, var_data->constraint);
+    const num_t marker_slope = -1.0f / marker_coefficient(cons);
+
+    // same rows as delta_constant moves
+    num_t min_delta = -NUM_MAX, max_delta = NUM_MAX;
+    if (has_row(&solver->terms, cons->marker)) {
+        narrow_constant_range(solver, cons->marker, -marker_slope, &min_delta, &max_delta);
+    } else if (cons->other && has_row(&solver->terms, cons->other)) {
+        narrow_constant_range(solver, cons->other, marker_slope, &min_delta, &max_delta);
+    } else {
+        // marker symbol const iteration
+        for (auto sym_iter = first_symbol_iterator(&solver->terms, cons->marker); 
+                sym_iter.term_res.term; 
+                sym_iter = next_symbol_iterator(&solver->terms, sym_iter) ) {
+            auto term = sym_iter.term_res.term;
+            narrow_constant_range(solver, term->pos.row, term->multiplier * marker_slope, &min_delta, &max_delta);
+        }
+    }
+
+    *out_min = min_delta > -NUM_MAX ? edit_value + min_delta : -NUM_MAX;
+    *out_max = max_delta < NUM_MAX ? edit_value + max_delta : NUM_MAX;
+    return result_e::OK;
+}
+
+num_t edit_slope(solver_t *solver, symbol_t edit_var, symbol_t var) {
+    assert(solver);
+
+    finish_solve(solver);
+
+    auto edit_data = get_var_data(solver, edit_var);
+    if (!edit_data->constraint) return 0.0f;
+
+    // alias marker is dummy, it is never moved
+    auto var_data = get_var_data(solver, var);
+    if (var_data->alias) return var_data->scale * edit_slope(solver, edit_var, var_data->alias);
+
+    auto cons = constraint_data(solver, edit_data->constraint);
+    return var_data->scale * constant_row_slope(solver, cons, var);
+}
+
+result_e set_constraint_constant(solver_t *solver, 
+        uint32_t count, const constraint_handle_t* cons, const num_t* constants) {
+    assert(solver);
+    assert((cons && constants) || !count);
+
+    // required conflicts are told apart from pending suggest rows
+    finish_solve(solver);
+    clear_basis_cache(solver);
+    // stored constants are updated once the change is resolved
+    for (uint32_t i = 0; i < count; ++i) {
+        if (!cons[i]) continue;
+        num_t delta = constants[i] - constraint_data(solver, cons[i])->constant;
+        delta_constant(solver, delta, cons[i]);
+    }
+
+    result_e ret = dual_optimize(solver);
+    for (uint32_t i = 0; i < count; ++i) {
+        if (!cons[i]) continue;
+
+        auto cons_data = constraint_data(solver, cons[i]);
+        if (ret == result_e::OK) {
+            cons_data->constant = constants[i];
+        } else {
+            // dual pivots keep the objective optimal, the previous constants are feasible again
+            delta_constant(solver, cons_data->constant - constants[i], cons[i]);
+        }
+    }
+
+    if (ret != result_e::OK) {
+        mark_infeasible_rows(solver);
+        auto res = dual_optimize(solver);
+        assert(res == result_e::OK);
+        (void)res;
+    }
+    return ret;
+}
+
+result_e set_constraint_constant(solver_t *solver, constraint_handle_t cons, num_t constant) {
+    return set_constraint_constant(solver, 1, &cons, &constant);
+}
+
+result_e set_constraint_strength(solver_t *solver, constraint_handle_t cons, num_t strength) {
+    assert(solver);
+    finish_solve(solver);
+    clear_basis_cache(solver);
+    if (!cons) return result_e::FAILED;
+
+    auto cons_data = constraint_data(solver, cons);
+    if (cons_data->strength == strength) return result_e::OK;
+
+    // required constraint rows have no error symbols, the row would have to be remade
+    if (cons_data->strength >= STRENGTH_REQUIRED || strength >= STRENGTH_REQUIRED) 
+        return result_e::FAILED;
+
+    // strength is the objective coefficient of the error symbols only
+    num_t delta = strength - cons_data->strength;
+    cons_data->strength = strength;
+    if (cons_data->disabled) return result_e::OK;
+
+    symbol_t objective = component_objective(solver, cons_data->marker);
+    if (is_error(solver, cons_data->marker))
+        merge_row(&solver->allocator, &solver->terms, objective, cons_data->marker, delta);
+    if (cons_data->other && is_error(solver, cons_data->other))
+        merge_row(&solver->allocator, &solver->terms, objective, cons_data->other, delta);
+
+    // basis stays feasible, only optimality is affected
+    return optimize(solver, objective);
+}
+
+result_e set_constraint_enabled(solver_t *solver, 
+        uint32_t count, const constraint_handle_t* cons, bool enabled) {
+    assert(solver);
+    assert(cons || !count);
+    finish_solve(solver);
+    clear_basis_cache(solver);
+
+    result_e ret = result_e::OK;
+    bool changed = false;
+    for (uint32_t i = 0; i < count; ++i) {
+        if (!cons[i] || constraint_data(solver, cons[i])->disabled != enabled) continue;
+
+        result_e cons_ret = result_e::OK;
+        if (enabled) {
+            cons_ret = enable_constraint(solver, cons[i]);
+        } else {
+            disable_constraint(solver, cons[i]);
+        }
+
+        // failed row can still leave artificial pivots behind
+        changed = true;
+        if (ret == result_e::OK) ret = cons_ret;
+    }
+
+    // rows are kept feasible, objective is optimized once for all changes
+    if (changed) {
+        optimize_changed(solver);
+    }
+
+    assert(solver->infeasible_components == 0);
+    return ret;
+}
+
+result_e set_constraint_enabled(solver_t *solver, constraint_handle_t cons, bool enabled) {
+    return set_constraint_enabled(solver, 1, &cons, enabled);
+}
+
+bool is_constraint_enabled(solver_t *solver, constraint_handle_t cons) {
+    assert(solver);
+    return cons && !constraint_data(solver, cons)->disabled;
+}
+
 }
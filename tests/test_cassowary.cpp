@@ -1,8 +1,39 @@
 #include "catch2/catch.hpp"
 #include "tokoeka/solver.h"
+#include <vector>
 
 using namespace tokoeka;
 
+struct test_term_t {
+    symbol_t symbol;
+    num_t multiplier;
+};
+
+/**
+ * Add constraint of the given terms
+ * @return constraint handle, 0 if the constraint is not added
+ */
+static constraint_handle_t add(solver_t *S, const std::vector<test_term_t>& terms, relation_e relation, num_t strength, num_t constant) {
+    std::vector<symbol_t> symbols;
+    std::vector<num_t> multipiers;
+    for (const test_term_t& term : terms) {
+        symbols.push_back(term.symbol);
+        multipiers.push_back(term.multiplier);
+    }
+
+    constraint_desc_t desc = {};
+    desc.strength = strength;
+    desc.term_count = (uint32_t)terms.size();
+    desc.symbols = symbols.data();
+    desc.multipliers = multipiers.data();
+    desc.relation = relation;
+    desc.constant = constant;
+
+    constraint_handle_t cons = 0u;
+    add_constraint(S, &desc, &cons);
+    return cons;
+}
+
 TEST_CASE("simple (x==18)", "[cassowary]") {
     solver_desc_t solver_desc = {};
     solver_t *S = create_solver(&solver_desc);
@@ -352,6 +383,1199 @@ TEST_CASE("match heights", "[cassowary]") {
     destroy_solver(S);
 }
 
+TEST_CASE("create variables range", "[cassowary]") {
+    solver_desc_t solver_desc = {};
+    solver_t *S = create_solver(&solver_desc);
+
+    symbol_t a = create_variable(S);
+    delete_variable(S, a);
+
+    const uint32_t count = 600;
+    symbol_t first = create_variables(S, count);
+    // freed handle is not reused by the range
+    REQUIRE(first > a);
+    REQUIRE(create_variables(S, 0) == 0);
+
+    // x[i] == i
+    for (uint32_t i = 0; i < count; ++i) {
+        symbol_t symbols[] = {(symbol_t)(first + i)};
+        num_t multipiers[] = {1.0f};
+
+        constraint_desc_t desc = {};
+        desc.strength = STRENGTH_REQUIRED;
+        desc.term_count = 1;
+        desc.symbols = symbols;
+        desc.multipliers = multipiers;
+        desc.relation = relation_e::EQUAL;
+        desc.constant = (num_t)i;
+
+        constraint_handle_t cons;
+        REQUIRE(add_constraint(S, &desc, &cons) == result_e::OK);
+    }
+
+    std::vector<num_t> vals(count);
+    values(S, first, count, vals.data());
+    for (uint32_t i = 0; i < count; ++i) {
+        REQUIRE(vals[i] == (num_t)i);
+    }
+
+    destroy_solver(S);
+}
+
+TEST_CASE("delete variables with constraints", "[cassowary]") {
+    solver_desc_t solver_desc = {};
+    solver_t *S = create_solver(&solver_desc);
+
+    symbol_t x = create_variable(S);
+    symbol_t y = create_variable(S);
+    symbol_t z = create_variable(S);
+
+    REQUIRE(add(S, {{x, 1.0f}}, relation_e::EQUAL, STRENGTH_REQUIRED, 10.0f));             // x == 10
+    REQUIRE(add(S, {{y, 1.0f}, {x, -1.0f}}, relation_e::EQUAL, STRENGTH_REQUIRED, 5.0f));  // y == x + 5
+    REQUIRE(add(S, {{z, 1.0f}}, relation_e::EQUAL, STRENGTH_REQUIRED, 20.0f));             // z == 20
+    enable_edit(S, x, STRENGTH_STRONG);
+    suggest(S, x, 30.0f);
+    REQUIRE(value(S, y) == 15.0f);
+
+    // x constraints go away with it, y is free then
+    symbol_t vars[] = {x, 0};
+    delete_variables(S, 2, vars);
+    REQUIRE(value(S, y) == 0.0f);
+    REQUIRE(value(S, z) == 20.0f);
+
+    delete_variable(S, y);
+
+    // handles are reusable
+    symbol_t w = create_variable(S);
+    REQUIRE(add(S, {{w, 1.0f}, {z, -1.0f}}, relation_e::EQUAL, STRENGTH_REQUIRED, 1.0f));  // w == z + 1
+    REQUIRE(value(S, w) == 21.0f);
+
+    // repeated handle is deleted once
+    symbol_t repeated_vars[] = {z, z};
+    delete_variables(S, 2, repeated_vars);
+    REQUIRE(value(S, w) == 0.0f);
+
+    destroy_solver(S);
+}
+
+TEST_CASE("add constraints batch", "[cassowary]") {
+    solver_desc_t solver_desc = {};
+    solver_t *S = create_solver(&solver_desc);
+
+    symbol_t x = create_variable(S);
+    symbol_t y = create_variable(S);
+
+    symbol_t x_symbols[] = {x};
+    symbol_t xy_symbols[] = {y, x};
+    num_t x_multipiers[] = {1.0f};
+    num_t xy_multipiers[] = {1.0f, -1.0f};
+
+    constraint_desc_t descs[3] = {};
+    // x == 10
+    descs[0].strength = STRENGTH_REQUIRED;
+    descs[0].term_count = 1;
+    descs[0].symbols = x_symbols;
+    descs[0].multipliers = x_multipiers;
+    descs[0].relation = relation_e::EQUAL;
+    descs[0].constant = 10.0f;
+    // x == 20, conflicts with the first one
+    descs[1] = descs[0];
+    descs[1].constant = 20.0f;
+    // y == x + 5
+    descs[2].strength = STRENGTH_REQUIRED;
+    descs[2].term_count = 2;
+    descs[2].symbols = xy_symbols;
+    descs[2].multipliers = xy_multipiers;
+    descs[2].relation = relation_e::EQUAL;
+    descs[2].constant = 5.0f;
+
+    constraint_handle_t cons[3] = {};
+    result_e results[3] = {};
+    result_e r = add_constraints(S, 3, descs, cons, results);
+    REQUIRE(r == result_e::UNSATISFIED);
+    REQUIRE(results[0] == result_e::OK);
+    REQUIRE(results[1] == result_e::UNSATISFIED);
+    REQUIRE(results[2] == result_e::OK);
+    REQUIRE(cons[0]);
+    REQUIRE(!cons[1]);
+    REQUIRE(cons[2]);
+
+    REQUIRE(value(S, x) == 10.0f);
+    REQUIRE(value(S, y) == 15.0f);
+
+    destroy_solver(S);
+}
+
+TEST_CASE("unsatisfied required inequality", "[cassowary]") {
+    solver_desc_t solver_desc = {};
+    solver_t *S = create_solver(&solver_desc);
+
+    symbol_t x = create_variable(S);
+    symbol_t y = create_variable(S);
+
+    // y == x + 5
+    REQUIRE(add(S, {{y, 1.0f}, {x, -1.0f}}, relation_e::EQUAL, STRENGTH_REQUIRED, 5.0f));
+    REQUIRE(add(S, {{x, 1.0f}}, relation_e::GREATEQUAL, STRENGTH_REQUIRED, 10.0f));
+    REQUIRE(add(S, {{y, 1.0f}}, relation_e::EQUAL, STRENGTH_WEAK, 40.0f));
+    REQUIRE(value(S, x) == 35.0f);
+
+    // every row symbol is restricted, the row is added with an artificial variable which can't reach zero
+    REQUIRE(!add(S, {{y, 1.0f}}, relation_e::LESSEQUAL, STRENGTH_REQUIRED, 12.0f));
+    REQUIRE(value(S, x) == 35.0f);
+    REQUIRE(value(S, y) == 40.0f);
+
+    // the rest of the tableau is intact
+    REQUIRE(add(S, {{y, 1.0f}}, relation_e::LESSEQUAL, STRENGTH_REQUIRED, 30.0f));
+    REQUIRE(value(S, x) == 25.0f);
+    REQUIRE(value(S, y) == 30.0f);
+
+    destroy_solver(S);
+}
+
+TEST_CASE("remove constraints batch", "[cassowary]") {
+    solver_desc_t solver_desc = {};
+    solver_t *S = create_solver(&solver_desc);
+
+    symbol_t x = create_variable(S);
+
+    symbol_t symbols[] = {x};
+    num_t multipiers[] = {1.0f};
+
+    constraint_desc_t desc = {};
+    desc.term_count = 1;
+    desc.symbols = symbols;
+    desc.multipliers = multipiers;
+
+    // x == 5 (weak)
+    desc.strength = STRENGTH_WEAK;
+    desc.relation = relation_e::EQUAL;
+    desc.constant = 5.0f;
+    constraint_handle_t weak_cons;
+    REQUIRE(add_constraint(S, &desc, &weak_cons) == result_e::OK);
+
+    // x >= 10, x >= 20 (strong), x <= 30
+    constraint_handle_t cons[4] = {};
+    desc.strength = STRENGTH_REQUIRED;
+    desc.relation = relation_e::GREATEQUAL;
+    desc.constant = 10.0f;
+    REQUIRE(add_constraint(S, &desc, &cons[0]) == result_e::OK);
+    desc.strength = STRENGTH_STRONG;
+    desc.constant = 20.0f;
+    REQUIRE(add_constraint(S, &desc, &cons[1]) == result_e::OK);
+    desc.strength = STRENGTH_REQUIRED;
+    desc.relation = relation_e::LESSEQUAL;
+    desc.constant = 30.0f;
+    REQUIRE(add_constraint(S, &desc, &cons[3]) == result_e::OK);
+    REQUIRE(value(S, x) == 20.0f);
+
+    // null handles are skipped
+    remove_constraints(S, 4, cons);
+    REQUIRE(value(S, x) == 5.0f);
+
+    remove_constraints(S, 1, &weak_cons);
+    REQUIRE(add_constraint(S, &desc, &cons[0]) == result_e::OK);
+
+    destroy_solver(S);
+}
+
+TEST_CASE("set constraint constant", "[cassowary]") {
+    solver_desc_t solver_desc = {};
+    solver_t *S = create_solver(&solver_desc);
+
+    symbol_t x = create_variable(S);
+    symbol_t y = create_variable(S);
+
+    auto x_min = add(S, {{x, 1.0f}}, relation_e::GREATEQUAL, STRENGTH_REQUIRED, 10.0f);
+    auto x_max = add(S, {{x, 1.0f}}, relation_e::LESSEQUAL, STRENGTH_REQUIRED, 100.0f);
+    auto x_pref = add(S, {{x, 1.0f}}, relation_e::EQUAL, STRENGTH_WEAK, 0.0f);
+    auto spacing = add(S, {{y, 1.0f}, {x, -1.0f}}, relation_e::EQUAL, STRENGTH_REQUIRED, 5.0f);
+    REQUIRE((x_min && x_max && x_pref && spacing));
+    REQUIRE(value(S, x) == 10.0f);
+    REQUIRE(value(S, y) == 15.0f);
+
+    REQUIRE(set_constraint_constant(S, x_min, 25.0f) == result_e::OK);
+    REQUIRE(value(S, x) == 25.0f);
+    REQUIRE(value(S, y) == 30.0f);
+
+    REQUIRE(set_constraint_constant(S, spacing, -5.0f) == result_e::OK);
+    REQUIRE(value(S, y) == 20.0f);
+
+    REQUIRE(set_constraint_constant(S, x_pref, 50.0f) == result_e::OK);
+    REQUIRE(value(S, x) == 50.0f);
+
+    // x >= 120 conflicts with x <= 100, nothing changes
+    constraint_handle_t cons[] = {x_min, spacing};
+    num_t constants[] = {120.0f, 0.0f};
+    REQUIRE(set_constraint_constant(S, 2, cons, constants) == result_e::UNSATISFIED);
+    REQUIRE(value(S, x) == 50.0f);
+    REQUIRE(value(S, y) == 45.0f);
+
+    constants[0] = 60.0f;
+    REQUIRE(set_constraint_constant(S, 2, cons, constants) == result_e::OK);
+    REQUIRE(value(S, x) == 60.0f);
+    REQUIRE(value(S, y) == 60.0f);
+
+    REQUIRE(set_constraint_constant(S, x_max, 70.0f) == result_e::OK);
+    REQUIRE(set_constraint_constant(S, x_pref, 80.0f) == result_e::OK);
+    REQUIRE(value(S, x) == 70.0f);
+
+    destroy_solver(S);
+}
+
+TEST_CASE("set constraint strength", "[cassowary]") {
+    solver_desc_t solver_desc = {};
+    solver_t *S = create_solver(&solver_desc);
+
+    symbol_t x = create_variable(S);
+
+    auto x_min = add(S, {{x, 1.0f}}, relation_e::GREATEQUAL, STRENGTH_REQUIRED, 0.0f);
+    auto x_10 = add(S, {{x, 1.0f}}, relation_e::EQUAL, STRENGTH_MEDIUM, 10.0f);
+    auto x_20 = add(S, {{x, 1.0f}}, relation_e::EQUAL, STRENGTH_WEAK, 20.0f);
+    auto x_max = add(S, {{x, 1.0f}}, relation_e::LESSEQUAL, STRENGTH_WEAK, 15.0f);
+    REQUIRE((x_min && x_10 && x_20 && x_max));
+    REQUIRE(value(S, x) == 10.0f);
+
+    REQUIRE(set_constraint_strength(S, x_20, STRENGTH_STRONG) == result_e::OK);
+    REQUIRE(value(S, x) == 20.0f);
+
+    // inequality error symbol
+    REQUIRE(set_constraint_strength(S, x_max, STRENGTH_STRONG + STRENGTH_MEDIUM) == result_e::OK);
+    REQUIRE(value(S, x) == 15.0f);
+
+    REQUIRE(set_constraint_strength(S, x_20, STRENGTH_WEAK) == result_e::OK);
+    REQUIRE(set_constraint_strength(S, x_max, STRENGTH_WEAK) == result_e::OK);
+    REQUIRE(value(S, x) == 10.0f);
+
+    REQUIRE(set_constraint_strength(S, x_min, STRENGTH_STRONG) == result_e::FAILED);
+    REQUIRE(set_constraint_strength(S, x_10, STRENGTH_REQUIRED) == result_e::FAILED);
+    REQUIRE(value(S, x) == 10.0f);
+
+    destroy_solver(S);
+}
+
+TEST_CASE("enable and disable constraints", "[cassowary]") {
+    solver_desc_t solver_desc = {};
+    solver_t *S = create_solver(&solver_desc);
+
+    symbol_t x = create_variable(S);
+    symbol_t y = create_variable(S);
+
+    auto x_pref = add(S, {{x, 1.0f}}, relation_e::EQUAL, STRENGTH_WEAK, 10.0f);
+    auto x_strong = add(S, {{x, 1.0f}}, relation_e::EQUAL, STRENGTH_STRONG, 40.0f);
+    auto x_min = add(S, {{x, 1.0f}}, relation_e::GREATEQUAL, STRENGTH_REQUIRED, 20.0f);
+    auto spacing = add(S, {{y, 1.0f}, {x, -1.0f}}, relation_e::EQUAL, STRENGTH_REQUIRED, 5.0f);
+    REQUIRE((x_pref && x_strong && x_min && spacing));
+    REQUIRE(value(S, x) == 40.0f);
+    REQUIRE(value(S, y) == 45.0f);
+
+    // relaxed to zero strength
+    REQUIRE(set_constraint_enabled(S, x_strong, false) == result_e::OK);
+    REQUIRE(!is_constraint_enabled(S, x_strong));
+    REQUIRE(value(S, x) == 20.0f);
+
+    // required rows are removed
+    constraint_handle_t cons[] = {x_min, spacing};
+    REQUIRE(set_constraint_enabled(S, 2, cons, false) == result_e::OK);
+    REQUIRE(value(S, x) == 10.0f);
+    REQUIRE(value(S, y) == 0.0f);
+
+    // disabled constraint still takes constant and strength changes
+    REQUIRE(set_constraint_constant(S, x_min, 30.0f) == result_e::OK);
+    REQUIRE(set_constraint_strength(S, x_strong, STRENGTH_MEDIUM) == result_e::OK);
+    REQUIRE(value(S, x) == 10.0f);
+
+    REQUIRE(set_constraint_enabled(S, 2, cons, true) == result_e::OK);
+    REQUIRE(is_constraint_enabled(S, x_min));
+    REQUIRE(value(S, x) == 30.0f);
+    REQUIRE(value(S, y) == 35.0f);
+
+    REQUIRE(set_constraint_enabled(S, x_strong, true) == result_e::OK);
+    REQUIRE(value(S, x) == 40.0f);
+
+    // conflicting required constraint stays disabled
+    auto x_max = add(S, {{x, 1.0f}}, relation_e::LESSEQUAL, STRENGTH_REQUIRED, 50.0f);
+    REQUIRE(x_max);
+    REQUIRE(set_constraint_enabled(S, x_max, false) == result_e::OK);
+    REQUIRE(set_constraint_constant(S, x_max, 25.0f) == result_e::OK);
+    REQUIRE(set_constraint_enabled(S, x_max, true) != result_e::OK);
+    REQUIRE(!is_constraint_enabled(S, x_max));
+    REQUIRE(value(S, x) == 40.0f);
+
+    remove_constraint(S, x_max);
+    remove_constraint(S, x_pref);
+    symbol_t vars[] = {x};
+    delete_variables(S, 1, vars);
+    REQUIRE(value(S, y) == 0.0f);
+
+    destroy_solver(S);
+}
+
+TEST_CASE("native variable bounds", "[cassowary]") {
+    solver_desc_t solver_desc = {};
+    solver_t *S = create_solver(&solver_desc);
+
+    symbol_t vars[2] = {};
+    vars[0] = create_variable(S);
+    vars[1] = create_variable(S);
+    symbol_t x = vars[0];
+    symbol_t y = vars[1];
+
+    // x >= 10, 2y <= 30
+    auto x_min = add(S, {{x, 1.0f}}, relation_e::GREATEQUAL, STRENGTH_REQUIRED, 10.0f);
+    auto y_max = add(S, {{y, 2.0f}}, relation_e::LESSEQUAL, STRENGTH_REQUIRED, 30.0f);
+    add(S, {{x, 1.0f}}, relation_e::EQUAL, STRENGTH_WEAK, 0.0f);
+    add(S, {{y, 1.0f}}, relation_e::EQUAL, STRENGTH_WEAK, 100.0f);
+    REQUIRE(value(S, x) == 10.0f);
+    REQUIRE(value(S, y) == 15.0f);
+
+    num_t vals[2] = {};
+    values(S, x, 2, vals);
+    REQUIRE(vals[0] == 10.0f);
+    REQUIRE(vals[1] == 15.0f);
+
+    clear_changed_variables(S);
+    REQUIRE(set_constraint_constant(S, x_min, 20.0f) == result_e::OK);
+    REQUIRE(value(S, x) == 20.0f);
+    symbol_t changed[2] = {};
+    REQUIRE(pop_changed_variables(S, changed, 2) == 1);
+    REQUIRE(changed[0] == x);
+
+    REQUIRE(set_constraint_enabled(S, x_min, false) == result_e::OK);
+    REQUIRE(value(S, x) == 0.0f);
+    REQUIRE(set_constraint_enabled(S, x_min, true) == result_e::OK);
+    REQUIRE(value(S, x) == 20.0f);
+
+    // second bound of the same variable is a row
+    add(S, {{x, 1.0f}}, relation_e::LESSEQUAL, STRENGTH_REQUIRED, 50.0f);
+    add(S, {{x, 1.0f}}, relation_e::EQUAL, STRENGTH_STRONG, 100.0f);
+    REQUIRE(value(S, x) == 50.0f);
+    REQUIRE(!add(S, {{x, 1.0f}}, relation_e::LESSEQUAL, STRENGTH_REQUIRED, 5.0f));
+
+    remove_constraint(S, y_max);
+    REQUIRE(value(S, y) == 100.0f);
+
+    delete_variables(S, 2, vars);
+
+    destroy_solver(S);
+}
+
+TEST_CASE("alias variables", "[cassowary]") {
+    solver_desc_t solver_desc = {};
+    solver_t *S = create_solver(&solver_desc);
+
+    symbol_t vars[3] = {};
+    vars[0] = create_variable(S);
+    vars[1] = create_variable(S);
+    vars[2] = create_variable(S);
+    symbol_t x = vars[0];
+    symbol_t y = vars[1];
+    symbol_t z = vars[2];
+
+    // x >= 10, y == x + 10, 2z - y == 10
+    add(S, {{x, 1.0f}}, relation_e::GREATEQUAL, STRENGTH_REQUIRED, 10.0f);
+    auto y_eq = add(S, {{y, 1.0f}, {x, -1.0f}}, relation_e::EQUAL, STRENGTH_REQUIRED, 10.0f);
+    auto z_eq = add(S, {{z, 2.0f}, {y, -1.0f}}, relation_e::EQUAL, STRENGTH_REQUIRED, 10.0f);
+    add(S, {{z, 1.0f}}, relation_e::EQUAL, STRENGTH_WEAK, 100.0f);
+    REQUIRE(value(S, x) == 180.0f);
+    REQUIRE(value(S, y) == 190.0f);
+    REQUIRE(value(S, z) == 100.0f);
+
+    num_t vals[3] = {};
+    values(S, x, 3, vals);
+    REQUIRE(vals[0] == 180.0f);
+    REQUIRE(vals[1] == 190.0f);
+    REQUIRE(vals[2] == 100.0f);
+
+    // aliased variables are moved along
+    clear_changed_variables(S);
+    add(S, {{x, 1.0f}}, relation_e::LESSEQUAL, STRENGTH_REQUIRED, 50.0f);
+    REQUIRE(value(S, x) == 50.0f);
+    REQUIRE(value(S, z) == 35.0f);
+    symbol_t changed[3] = {};
+    REQUIRE(pop_changed_variables(S, changed, 3) == 3);
+    REQUIRE(pop_changed_variables(S, changed, 3) == 0);
+
+    REQUIRE(set_constraint_constant(S, z_eq, 30.0f) == result_e::OK);
+    REQUIRE(value(S, z) == 45.0f);
+    REQUIRE(pop_changed_variables(S, changed, 3) == 1);
+    REQUIRE(changed[0] == z);
+
+    REQUIRE(set_constraint_enabled(S, y_eq, false) == result_e::OK);
+    REQUIRE(value(S, x) == 50.0f);
+    REQUIRE(value(S, z) == 100.0f);
+    REQUIRE(value(S, y) == 170.0f);
+    REQUIRE(set_constraint_enabled(S, y_eq, true) == result_e::OK);
+    REQUIRE(value(S, y) == 60.0f);
+    REQUIRE(value(S, z) == 45.0f);
+
+    remove_constraint(S, z_eq);
+    REQUIRE(value(S, z) == 100.0f);
+    REQUIRE(value(S, y) == 60.0f);
+
+    REQUIRE(!add(S, {{y, 1.0f}, {x, -1.0f}}, relation_e::EQUAL, STRENGTH_REQUIRED, 20.0f));
+    delete_variables(S, 3, vars);
+
+    destroy_solver(S);
+}
+
+TEST_CASE("clone and restore solver", "[cassowary]") {
+    solver_desc_t solver_desc = {};
+    solver_t *S = create_solver(&solver_desc);
+
+    symbol_t x = create_variable(S);
+    symbol_t y = create_variable(S);
+
+    // x + y == 100, x >= 10, x == 20 (weak)
+    add(S, {{x, 1.0f}, {y, 1.0f}}, relation_e::EQUAL, STRENGTH_REQUIRED, 100.0f);
+    add(S, {{x, 1.0f}}, relation_e::GREATEQUAL, STRENGTH_REQUIRED, 10.0f);
+    add(S, {{x, 1.0f}}, relation_e::EQUAL, STRENGTH_WEAK, 20.0f);
+    REQUIRE(enable_edit(S, y, STRENGTH_STRONG) == result_e::OK);
+    suggest(S, y, 70.0f);
+    REQUIRE(value(S, x) == 30.0f);
+
+    solver_t *snapshot = clone_solver(S);
+    REQUIRE(value(snapshot, x) == 30.0f);
+    REQUIRE(value(snapshot, y) == 70.0f);
+
+    // speculative changes grow every buffer
+    const uint32_t var_count = 600;
+    symbol_t first = create_variables(S, var_count);
+    REQUIRE(first);
+    for (uint32_t i = 0; i < var_count; ++i) {
+        symbol_t prev = i ? (symbol_t)(first + i - 1) : x;
+        add(S, {{(symbol_t)(first + i), 1.0f}, {prev, -1.0f}}, relation_e::GREATEQUAL, STRENGTH_REQUIRED, 1.0f);
+        add(S, {{(symbol_t)(first + i), 1.0f}}, relation_e::EQUAL, STRENGTH_WEAK, 0.0f);
+    }
+    suggest(S, y, 95.0f);
+    REQUIRE(value(S, x) == 10.0f);
+    REQUIRE(value(S, (symbol_t)(first + var_count - 1)) == 10.0f + var_count);
+
+    restore_solver(S, snapshot);
+    REQUIRE(value(S, x) == 30.0f);
+    REQUIRE(value(S, y) == 70.0f);
+
+    // restored solver is usable, snapshot is intact
+    suggest(S, y, 60.0f);
+    REQUIRE(value(S, x) == 40.0f);
+    REQUIRE(value(snapshot, x) == 30.0f);
+    symbol_t z = create_variable(S);
+    add(S, {{z, 1.0f}, {x, -1.0f}}, relation_e::EQUAL, STRENGTH_REQUIRED, 5.0f);
+    REQUIRE(value(S, z) == 45.0f);
+
+    restore_solver(S, snapshot);
+    suggest(S, y, 80.0f);
+    REQUIRE(value(S, x) == 20.0f);
+
+    destroy_solver(snapshot);
+    destroy_solver(S);
+}
+
+TEST_CASE("save and load solver", "[cassowary]") {
+    solver_desc_t solver_desc = {};
+    solver_t *S = create_solver(&solver_desc);
+
+    const uint32_t var_count = 300;
+    symbol_t first = create_variables(S, var_count);
+    REQUIRE(first);
+
+    // vars[i + 1] >= vars[i] + 2, vars[i] == 0 (weak)
+    for (uint32_t i = 0; i < var_count; ++i) {
+        symbol_t var = (symbol_t)(first + i);
+        if (i) {
+            symbol_t symbols[] = {var, (symbol_t)(var - 1)};
+            num_t multipiers[] = {1.0f, -1.0f};
+
+            constraint_desc_t desc = {};
+            desc.strength = STRENGTH_REQUIRED;
+            desc.term_count = 2;
+            desc.symbols = symbols;
+            desc.multipliers = multipiers;
+            desc.relation = relation_e::GREATEQUAL;
+            desc.constant = 2.0f;
+
+            constraint_handle_t c;
+            REQUIRE(add_constraint(S, &desc, &c) == result_e::OK);
+        }
+        symbol_t symbols[] = {var};
+        num_t multipiers[] = {1.0f};
+
+        constraint_desc_t desc = {};
+        desc.strength = STRENGTH_WEAK;
+        desc.term_count = 1;
+        desc.symbols = symbols;
+        desc.multipliers = multipiers;
+        desc.relation = relation_e::EQUAL;
+        desc.constant = 0.0f;
+
+        constraint_handle_t c;
+        REQUIRE(add_constraint(S, &desc, &c) == result_e::OK);
+    }
+    REQUIRE(enable_edit(S, first, STRENGTH_STRONG) == result_e::OK);
+    suggest(S, first, 10.0f);
+
+    size_t image_size = save_solver(S, nullptr, 0);
+    REQUIRE(image_size);
+    // image is not aligned within the buffer
+    std::vector<uint8_t> image(image_size + 1);
+    REQUIRE(save_solver(S, image.data() + 1, image_size - 1) == image_size);
+    REQUIRE(save_solver(S, image.data() + 1, image_size) == image_size);
+
+    solver_t *L = load_solver(&solver_desc, image.data() + 1, image_size);
+    REQUIRE(L);
+    std::vector<num_t> saved_values(var_count), loaded_values(var_count);
+    values(S, first, var_count, saved_values.data());
+    values(L, first, var_count, loaded_values.data());
+    REQUIRE(saved_values == loaded_values);
+    REQUIRE(value(L, (symbol_t)(first + var_count - 1)) == 10.0f + 2.0f * (var_count - 1));
+
+    // loaded solver keeps edit state and is usable
+    REQUIRE(has_edit(L, first));
+    suggest(L, first, 20.0f);
+    suggest(S, first, 20.0f);
+    values(S, first, var_count, saved_values.data());
+    values(L, first, var_count, loaded_values.data());
+    REQUIRE(saved_values == loaded_values);
+    symbol_t x = create_variable(L);
+    {
+        symbol_t symbols[] = {x, first};
+        num_t multipiers[] = {1.0f, -1.0f};
+
+        constraint_desc_t desc = {};
+        desc.strength = STRENGTH_REQUIRED;
+        desc.term_count = 2;
+        desc.symbols = symbols;
+        desc.multipliers = multipiers;
+        desc.relation = relation_e::EQUAL;
+        desc.constant = 5.0f;
+
+        constraint_handle_t c;
+        REQUIRE(add_constraint(L, &desc, &c) == result_e::OK);
+    }
+    REQUIRE(value(L, x) == 25.0f);
+
+    // malformed images
+    REQUIRE(!load_solver(&solver_desc, image.data() + 1, image_size - 1));
+    image[1] ^= 0xff;
+    REQUIRE(!load_solver(&solver_desc, image.data() + 1, image_size));
+    image[1] ^= 0xff;
+
+    // any single byte flip within records is rejected by the checksum
+    for (size_t offset = 1; offset <= image_size; offset += image_size / 64 + 1) {
+        image[offset] ^= (uint8_t)(1u << (offset % 8));
+        REQUIRE(!load_solver(&solver_desc, image.data() + 1, image_size));
+        image[offset] ^= (uint8_t)(1u << (offset % 8));
+    }
+    solver_t *R = load_solver(&solver_desc, image.data() + 1, image_size);
+    REQUIRE(R);
+    destroy_solver(R);
+
+    destroy_solver(L);
+    destroy_solver(S);
+}
+
+TEST_CASE("changed variables", "[cassowary]") {
+    solver_desc_t solver_desc = {};
+    solver_t *S = create_solver(&solver_desc);
+
+    symbol_t x = create_variable(S);
+    symbol_t y = create_variable(S);
+    symbol_t z = create_variable(S);
+
+    // y == x + 10
+    {
+        symbol_t symbols[] = {y,    x};
+        num_t multipiers[] = {1.0f, -1.0f};
+
+        constraint_desc_t desc = {};
+        desc.strength = STRENGTH_REQUIRED;
+        desc.term_count = 2;
+        desc.symbols = symbols;
+        desc.multipliers = multipiers;
+        desc.relation = relation_e::EQUAL;
+        desc.constant = 10.0f;
+
+        constraint_handle_t c;
+        result_e r = add_constraint(S, &desc, &c);
+        REQUIRE(r == result_e::OK);
+    }
+    // z == 5
+    {
+        symbol_t symbols[] = {z};
+        num_t multipiers[] = {1.0f};
+
+        constraint_desc_t desc = {};
+        desc.strength = STRENGTH_REQUIRED;
+        desc.term_count = 1;
+        desc.symbols = symbols;
+        desc.multipliers = multipiers;
+        desc.relation = relation_e::EQUAL;
+        desc.constant = 5.0f;
+
+        constraint_handle_t c;
+        result_e r = add_constraint(S, &desc, &c);
+        REQUIRE(r == result_e::OK);
+    }
+
+    symbol_t changed[4] = {};
+    REQUIRE(pop_changed_variables(S, changed, 4) == 2);
+    REQUIRE(pop_changed_variables(S, changed, 4) == 0);
+
+    enable_edit(S, x, STRENGTH_STRONG);
+    suggest(S, x, 20.);
+    REQUIRE(value(S, y) == 30.0f);
+
+    // z is not moved
+    REQUIRE(pop_changed_variables(S, changed, 1) == 1);
+    REQUIRE(pop_changed_variables(S, changed + 1, 3) == 1);
+    REQUIRE(((changed[0] == x && changed[1] == y) || (changed[0] == y && changed[1] == x)));
+
+    suggest(S, x, 30.);
+    clear_changed_variables(S);
+    REQUIRE(pop_changed_variables(S, changed, 4) == 0);
+
+    // native bound keeps the pending change of a variable moved out of the tableau, 
+    // w >= 0 and w <= 0 (as -w >= 0) map the value with scale 1 and -1
+    const num_t bound_multipliers[] = {1.0f, -1.0f};
+    for (num_t bound_multiplier : bound_multipliers) {
+        symbol_t w = create_variable(S);
+
+        constraint_handle_t weak_cons;
+        {
+            symbol_t symbols[] = {w};
+            num_t multipiers[] = {1.0f};
+
+            constraint_desc_t desc = {};
+            desc.strength = STRENGTH_WEAK;
+            desc.term_count = 1;
+            desc.symbols = symbols;
+            desc.multipliers = multipiers;
+            desc.relation = relation_e::EQUAL;
+            desc.constant = 331.0f;
+
+            REQUIRE(add_constraint(S, &desc, &weak_cons) == result_e::OK);
+        }
+        clear_changed_variables(S);
+
+        remove_constraint(S, weak_cons);
+        REQUIRE(value(S, w) == 0.0f);
+        {
+            symbol_t symbols[] = {w};
+            num_t multipiers[] = {bound_multiplier};
+
+            constraint_desc_t desc = {};
+            desc.strength = STRENGTH_REQUIRED;
+            desc.term_count = 1;
+            desc.symbols = symbols;
+            desc.multipliers = multipiers;
+            desc.relation = relation_e::GREATEQUAL;
+            desc.constant = 0.0f;
+
+            constraint_handle_t c;
+            REQUIRE(add_constraint(S, &desc, &c) == result_e::OK);
+        }
+        REQUIRE(value(S, w) == 0.0f);
+        REQUIRE(pop_changed_variables(S, changed, 4) == 1);
+        REQUIRE(changed[0] == w);
+    }
+
+    destroy_solver(S);
+}
+
+TEST_CASE("independent subsystems", "[cassowary]") {
+    solver_desc_t solver_desc = {};
+    solver_t *S = create_solver(&solver_desc);
+
+    // left + width == right, left >= 0 per subsystem
+    const uint32_t system_count = 8;
+    symbol_t lefts[system_count], widths[system_count], rights[system_count];
+    for (uint32_t i = 0; i < system_count; ++i) {
+        lefts[i] = create_variable(S);
+        widths[i] = create_variable(S);
+        rights[i] = create_variable(S);
+
+        {
+            symbol_t symbols[] = {lefts[i], widths[i], rights[i]};
+            num_t multipiers[] = {1.0f,     1.0f,      -1.0f};
+
+            constraint_desc_t desc = {};
+            desc.strength = STRENGTH_REQUIRED;
+            desc.term_count = 3;
+            desc.symbols = symbols;
+            desc.multipliers = multipiers;
+            desc.relation = relation_e::EQUAL;
+            desc.constant = 0.0f;
+
+            constraint_handle_t c;
+            REQUIRE(add_constraint(S, &desc, &c) == result_e::OK);
+        }
+        {
+            symbol_t symbols[] = {lefts[i]};
+            num_t multipiers[] = {1.0f};
+
+            constraint_desc_t desc = {};
+            desc.strength = STRENGTH_WEAK;
+            desc.term_count = 1;
+            desc.symbols = symbols;
+            desc.multipliers = multipiers;
+            desc.relation = relation_e::EQUAL;
+            desc.constant = 10.0f * i;
+
+            constraint_handle_t c;
+            REQUIRE(add_constraint(S, &desc, &c) == result_e::OK);
+        }
+        REQUIRE(enable_edit(S, widths[i], STRENGTH_STRONG) == result_e::OK);
+    }
+
+    for (uint32_t i = 0; i < system_count; ++i) {
+        suggest(S, widths[i], 100.0f + i);
+    }
+    clear_changed_variables(S);
+
+    // only the edited subsystem is moved
+    suggest(S, widths[3], 200.0f);
+    REQUIRE(value(S, rights[3]) == 230.0f);
+    symbol_t changed[system_count * 3] = {};
+    uint32_t changed_count = pop_changed_variables(S, changed, system_count * 3);
+    REQUIRE(changed_count == 2);
+    for (uint32_t i = 0; i < changed_count; ++i) {
+        REQUIRE((changed[i] == widths[3] || changed[i] == rights[3]));
+    }
+    for (uint32_t i = 0; i < system_count; ++i) {
+        REQUIRE(value(S, lefts[i]) == 10.0f * i);
+        if (i != 3) REQUIRE(value(S, rights[i]) == 100.0f + 11.0f * i);
+    }
+
+    destroy_solver(S);
+}
+
+TEST_CASE("connected components", "[cassowary]") {
+    solver_desc_t solver_desc = {};
+    solver_t *S = create_solver(&solver_desc);
+
+    symbol_t x = create_variable(S);
+    symbol_t y = create_variable(S);
+    REQUIRE(add(S, {{x, 1.0f}}, relation_e::EQUAL, STRENGTH_WEAK, 10.0f));
+    REQUIRE(add(S, {{y, 1.0f}}, relation_e::EQUAL, STRENGTH_WEAK, 20.0f));
+    REQUIRE(value(S, x) == 10.0f);
+    REQUIRE(value(S, y) == 20.0f);
+
+    // x + 5 <= y joins the components, y is moved and x follows it
+    constraint_handle_t joint = add(S, {{x, 1.0f}, {y, -1.0f}}, relation_e::LESSEQUAL, STRENGTH_REQUIRED, -5.0f);
+    constraint_handle_t y_medium = add(S, {{y, 1.0f}}, relation_e::EQUAL, STRENGTH_MEDIUM, 12.0f);
+    REQUIRE((joint && y_medium));
+    REQUIRE(value(S, x) == 7.0f);
+    REQUIRE(value(S, y) == 12.0f);
+
+    // joined component keeps a single objective, strength change is optimized within it
+    REQUIRE(set_constraint_strength(S, y_medium, STRENGTH_WEAK * 0.5f) == result_e::OK);
+    REQUIRE(value(S, x) == 10.0f);
+    REQUIRE(value(S, y) == 20.0f);
+    REQUIRE(set_constraint_strength(S, y_medium, STRENGTH_MEDIUM) == result_e::OK);
+
+    remove_constraint(S, joint);
+    REQUIRE(value(S, x) == 10.0f);
+    REQUIRE(value(S, y) == 12.0f);
+
+    // component records are a part of the image
+    std::vector<uint8_t> image(save_solver(S, nullptr, 0));
+    REQUIRE(save_solver(S, image.data(), image.size()) == image.size());
+    solver_t *L = load_solver(&solver_desc, image.data(), image.size());
+    REQUIRE(L);
+    REQUIRE(add(L, {{x, 1.0f}}, relation_e::EQUAL, STRENGTH_STRONG, 30.0f));
+    REQUIRE(value(L, x) == 30.0f);
+    REQUIRE(value(L, y) == 12.0f);
+    destroy_solver(L);
+
+    // unsatisfied required constraint joining components is dropped, the values are kept
+    symbol_t z = create_variable(S);
+    REQUIRE(add(S, {{z, 1.0f}}, relation_e::GREATEQUAL, STRENGTH_REQUIRED, 5.0f));
+    REQUIRE(add(S, {{x, 1.0f}}, relation_e::GREATEQUAL, STRENGTH_REQUIRED, 8.0f));
+    REQUIRE(!add(S, {{z, 1.0f}, {x, 1.0f}}, relation_e::LESSEQUAL, STRENGTH_REQUIRED, 12.0f));
+    REQUIRE(value(S, x) == 10.0f);
+    REQUIRE(value(S, y) == 12.0f);
+    REQUIRE(value(S, z) == 5.0f);
+
+    // deleted variables release their components, the solver is used as a new one
+    symbol_t vars[] = {x, y, z};
+    delete_variables(S, 3, vars);
+    symbol_t w = create_variable(S);
+    REQUIRE(add(S, {{w, 1.0f}}, relation_e::EQUAL, STRENGTH_WEAK, 3.0f));
+    REQUIRE(value(S, w) == 3.0f);
+
+    destroy_solver(S);
+}
+
+TEST_CASE("edit variable ranges", "[cassowary]") {
+    solver_desc_t solver_desc = {};
+    solver_t *S = create_solver(&solver_desc);
+
+    symbol_t left = create_variable(S);
+    symbol_t width = create_variable(S);
+    symbol_t right = create_variable(S);
+
+    // left + width == right
+    {
+        symbol_t symbols[] = {left, width, right};
+        num_t multipiers[] = {1.0f, 1.0f,  -1.0f};
+
+        constraint_desc_t desc = {};
+        desc.strength = STRENGTH_REQUIRED;
+        desc.term_count = 3;
+        desc.symbols = symbols;
+        desc.multipliers = multipiers;
+        desc.relation = relation_e::EQUAL;
+        desc.constant = 0.0f;
+
+        constraint_handle_t c;
+        REQUIRE(add_constraint(S, &desc, &c) == result_e::OK);
+    }
+    // right <= 300
+    {
+        symbol_t symbols[] = {right};
+        num_t multipiers[] = {1.0f};
+
+        constraint_desc_t desc = {};
+        desc.strength = STRENGTH_REQUIRED;
+        desc.term_count = 1;
+        desc.symbols = symbols;
+        desc.multipliers = multipiers;
+        desc.relation = relation_e::LESSEQUAL;
+        desc.constant = 300.0f;
+
+        constraint_handle_t c;
+        REQUIRE(add_constraint(S, &desc, &c) == result_e::OK);
+    }
+    // left == 10 weak
+    {
+        symbol_t symbols[] = {left};
+        num_t multipiers[] = {1.0f};
+
+        constraint_desc_t desc = {};
+        desc.strength = STRENGTH_WEAK;
+        desc.term_count = 1;
+        desc.symbols = symbols;
+        desc.multipliers = multipiers;
+        desc.relation = relation_e::EQUAL;
+        desc.constant = 10.0f;
+
+        constraint_handle_t c;
+        REQUIRE(add_constraint(S, &desc, &c) == result_e::OK);
+    }
+
+    num_t range_min = 0.0f, range_max = 0.0f;
+    REQUIRE(edit_range(S, width, &range_min, &range_max) == result_e::FAILED);
+    REQUIRE(edit_slope(S, width, right) == 0.0f);
+
+    REQUIRE(enable_edit(S, width, STRENGTH_STRONG) == result_e::OK);
+    suggest(S, width, 100.0f);
+    REQUIRE(value(S, right) == 110.0f);
+
+    // right bound is hit at width 290, width is unbounded below
+    REQUIRE(edit_range(S, width, &range_min, &range_max) == result_e::OK);
+    REQUIRE(range_max == Approx(290.0f));
+    REQUIRE(range_min < -1e30f);
+    REQUIRE(edit_slope(S, width, width) == Approx(1.0f));
+    REQUIRE(edit_slope(S, width, right) == Approx(1.0f));
+    REQUIRE(edit_slope(S, width, left) == 0.0f);
+
+    // values inside the range follow the slopes
+    num_t prev_right = value(S, right);
+    num_t right_slope = edit_slope(S, width, right);
+    suggest(S, width, 250.0f);
+    REQUIRE(value(S, right) == Approx(prev_right + right_slope * 150.0f));
+    REQUIRE(value(S, left) == 10.0f);
+
+    // past the range the basis changes, left is pushed by the right bound
+    REQUIRE(edit_range(S, width, &range_min, &range_max) == result_e::OK);
+    REQUIRE(range_max == Approx(290.0f));
+    suggest(S, width, 295.0f);
+    REQUIRE(value(S, right) == Approx(300.0f));
+    REQUIRE(value(S, left) == Approx(5.0f));
+
+    // new basis moves left instead of right
+    REQUIRE(edit_range(S, width, &range_min, &range_max) == result_e::OK);
+    REQUIRE(range_min == Approx(290.0f));
+    REQUIRE(edit_slope(S, width, left) == Approx(-1.0f));
+    REQUIRE(edit_slope(S, width, right) == 0.0f);
+
+    destroy_solver(S);
+}
+
+static solver_t* create_budget_test_solver(symbol_t* out_total, symbol_t* out_widths, uint32_t width_count) {
+    solver_desc_t solver_desc = {};
+    solver_t *S = create_solver(&solver_desc);
+
+    // sum of widths == total, 10 <= width <= 100, widths prefer 50
+    symbol_t total = create_variable(S);
+    std::vector<test_term_t> sum_terms = {{total, -1.0f}};
+    for (uint32_t i = 0; i < width_count; ++i) {
+        symbol_t width = create_variable(S);
+        out_widths[i] = width;
+        sum_terms.push_back({width, 1.0f});
+
+        REQUIRE(add(S, {{width, 1.0f}}, relation_e::GREATEQUAL, STRENGTH_REQUIRED, 10.0f));
+        REQUIRE(add(S, {{width, 1.0f}}, relation_e::LESSEQUAL, STRENGTH_REQUIRED, 100.0f));
+        REQUIRE(add(S, {{width, 1.0f}}, relation_e::EQUAL, STRENGTH_WEAK * (i + 1), 50.0f));
+    }
+    REQUIRE(add(S, sum_terms, relation_e::EQUAL, STRENGTH_REQUIRED, 0.0f));
+
+    REQUIRE(enable_edit(S, total, STRENGTH_STRONG) == result_e::OK);
+    suggest(S, total, 50.0f * width_count);
+    *out_total = total;
+    return S;
+}
+
+TEST_CASE("budgeted suggest", "[cassowary]") {
+    const uint32_t width_count = 16;
+    symbol_t total, widths[width_count];
+    solver_t *S = create_budget_test_solver(&total, widths, width_count);
+    symbol_t ref_total, ref_widths[width_count];
+    solver_t *R = create_budget_test_solver(&ref_total, ref_widths, width_count);
+
+    // squeezing every width moves many rows, one pivot at a time
+    suggest(R, ref_total, 10.0f * width_count + 5.0f);
+
+    num_t new_total = 10.0f * width_count + 5.0f;
+    REQUIRE(suggest(S, 1, &total, &new_total, 1) == result_e::PARTIAL);
+    uint32_t call_count = 1;
+    while (continue_solve(S, 1) == result_e::PARTIAL) {
+        ++call_count;
+        REQUIRE(call_count < 1000);
+    }
+    REQUIRE(call_count > 1);
+    REQUIRE(continue_solve(S, 1) == result_e::OK);
+
+    for (uint32_t i = 0; i < width_count; ++i) {
+        REQUIRE(value(S, widths[i]) == Approx(value(R, ref_widths[i])));
+    }
+    REQUIRE(value(S, total) == Approx(new_total));
+
+    // other changes finish a pending solve first
+    new_total = 60.0f * width_count;
+    REQUIRE(suggest(S, 1, &total, &new_total, 0) == result_e::PARTIAL);
+    suggest(R, ref_total, new_total);
+    REQUIRE(add(S, {{widths[0], 1.0f}}, relation_e::LESSEQUAL, STRENGTH_REQUIRED, 90.0f));
+    REQUIRE(add(R, {{ref_widths[0], 1.0f}}, relation_e::LESSEQUAL, STRENGTH_REQUIRED, 90.0f));
+    REQUIRE(continue_solve(S, 0) == result_e::OK);
+    for (uint32_t i = 0; i < width_count; ++i) {
+        REQUIRE(value(S, widths[i]) == Approx(value(R, ref_widths[i])));
+    }
+
+    destroy_solver(S);
+    destroy_solver(R);
+}
+
+TEST_CASE("basis cache", "[cassowary]") {
+    const uint32_t width_count = 16;
+    symbol_t total, widths[width_count];
+    solver_t *S = create_budget_test_solver(&total, widths, width_count);
+    symbol_t ref_total, ref_widths[width_count];
+    solver_t *R = create_budget_test_solver(&ref_total, ref_widths, width_count);
+    set_basis_cache(S, 4);
+
+    // the first suggest keeps the solved basis, squeezing pivots to another one
+    num_t wide_total = 50.0f * width_count;
+    num_t narrow_total = 10.0f * width_count + 5.0f;
+    suggest(S, total, wide_total);
+    suggest(S, total, narrow_total);
+    suggest(R, ref_total, narrow_total);
+    clear_changed_variables(S);
+    clear_changed_variables(R);
+
+    // both bases are kept, no pivots are needed to get back to any of them
+    num_t back_total = 50.0f * width_count - 20.0f;
+    REQUIRE(suggest(S, 1, &total, &back_total, 0) == result_e::OK);
+    suggest(R, ref_total, back_total);
+    for (uint32_t i = 0; i < width_count; ++i) {
+        REQUIRE(value(S, widths[i]) == Approx(value(R, ref_widths[i])));
+    }
+    REQUIRE(value(S, total) == Approx(back_total));
+
+    // variables moved by the jump are tracked as if pivots moved them
+    symbol_t changed[width_count + 1], ref_changed[width_count + 1];
+    uint32_t changed_count = pop_changed_variables(S, changed, width_count + 1);
+    REQUIRE(changed_count == pop_changed_variables(R, ref_changed, width_count + 1));
+    REQUIRE(changed_count > 1);
+
+    REQUIRE(suggest(S, 1, &total, &narrow_total, 0) == result_e::OK);
+    suggest(R, ref_total, narrow_total);
+    for (uint32_t i = 0; i < width_count; ++i) {
+        REQUIRE(value(S, widths[i]) == Approx(value(R, ref_widths[i])));
+    }
+
+    // clone has no cache
+    solver_t *C = clone_solver(S);
+    REQUIRE(suggest(C, 1, &total, &wide_total, 0) == result_e::PARTIAL);
+    destroy_solver(C);
+
+    // other changes drop kept bases, they have stale constants
+    REQUIRE(add(S, {{widths[width_count - 1], 1.0f}}, relation_e::LESSEQUAL, STRENGTH_REQUIRED, 40.0f));
+    REQUIRE(add(R, {{ref_widths[width_count - 1], 1.0f}}, relation_e::LESSEQUAL, STRENGTH_REQUIRED, 40.0f));
+    REQUIRE(suggest(S, 1, &total, &wide_total, 0) == result_e::PARTIAL);
+    REQUIRE(continue_solve(S, UINT32_MAX) == result_e::OK);
+    suggest(R, ref_total, wide_total);
+    for (uint32_t i = 0; i < width_count; ++i) {
+        REQUIRE(value(S, widths[i]) == Approx(value(R, ref_widths[i])));
+    }
+    REQUIRE(value(S, widths[width_count - 1]) == Approx(40.0f));
+
+    // disabled cache pivots again
+    set_basis_cache(S, 0);
+    REQUIRE(suggest(S, 1, &total, &narrow_total, 0) == result_e::PARTIAL);
+
+    destroy_solver(S);
+    destroy_solver(R);
+}
+
+TEST_CASE("chain of many variables", "[cassowary]") {
+    solver_desc_t solver_desc = {};
+    solver_t *S = create_solver(&solver_desc);
+
+    // more symbols than a single page of row scratch entries
+    const uint32_t var_count = 700;
+    symbol_t vars[var_count];
+    for (uint32_t i = 0; i < var_count; ++i) {
+        vars[i] = create_variable(S);
+    }
+
+    // vars[i + 1] == vars[i] + 1
+    for (uint32_t i = 0; i + 1 < var_count; ++i) {
+        symbol_t symbols[] = {vars[i + 1], vars[i]};
+        num_t multipiers[] = {1.0f,        -1.0f};
+
+        constraint_desc_t desc = {};
+        desc.strength = STRENGTH_REQUIRED;
+        desc.term_count = 2;
+        desc.symbols = symbols;
+        desc.multipliers = multipiers;
+        desc.relation = relation_e::EQUAL;
+        desc.constant = 1.0f;
+
+        constraint_handle_t c;
+        result_e r = add_constraint(S, &desc, &c);
+        REQUIRE(r == result_e::OK);
+    }
+
+    // vars[0] >= 10
+    {
+        symbol_t symbols[] = {vars[0]};
+        num_t multipiers[] = {1.0f};
+
+        constraint_desc_t desc = {};
+        desc.strength = STRENGTH_REQUIRED;
+        desc.term_count = 1;
+        desc.symbols = symbols;
+        desc.multipliers = multipiers;
+        desc.relation = relation_e::GREATEQUAL;
+        desc.constant = 10.0f;
+
+        constraint_handle_t c;
+        result_e r = add_constraint(S, &desc, &c);
+        REQUIRE(r == result_e::OK);
+    }
+
+    REQUIRE(value(S, vars[0]) == 10.0f);
+    REQUIRE(value(S, vars[var_count - 1]) == 10.0f + var_count - 1);
+
+    // variables are created before constraints, so their symbols are consecutive
+    num_t var_values[var_count];
+    values(S, vars[0], var_count, var_values);
+    for (uint32_t i = 0; i < var_count; ++i) {
+        REQUIRE(var_values[i] == 10.0f + i);
+    }
+
+    destroy_solver(S);
+}
+
+TEST_CASE("long column lists", "[cassowary]") {
+    solver_desc_t solver_desc = {};
+    solver_t *S = create_solver(&solver_desc);
+
+    // vars[i] == x + i, every row has an x term, so x column list grows with the term index
+    const uint32_t var_count = 400;
+    symbol_t x = create_variable(S);
+    symbol_t first = create_variables(S, var_count);
+    REQUIRE(first);
+    std::vector<constraint_handle_t> cons(var_count);
+    for (uint32_t i = 0; i < var_count; ++i) {
+        cons[i] = add(S, {{(symbol_t)(first + i), 1.0f}, {x, -1.0f}}, relation_e::EQUAL, STRENGTH_REQUIRED, (num_t)i);
+        REQUIRE(cons[i]);
+    }
+    REQUIRE(enable_edit(S, x, STRENGTH_STRONG) == result_e::OK);
+    suggest(S, x, 5.0f);
+    REQUIRE(value(S, (symbol_t)(first + var_count - 1)) == 5.0f + var_count - 1);
+
+    // terms are unlinked from the middle of the lists
+    for (uint32_t i = 1; i < var_count; i += 2) {
+        remove_constraint(S, cons[i]);
+    }
+    suggest(S, x, 7.0f);
+    for (uint32_t i = 0; i < var_count; ++i) {
+        REQUIRE(value(S, (symbol_t)(first + i)) == (i % 2 ? 0.0f : 7.0f + i));
+    }
+
+    // freed terms are reused by the new rows, vars[i] == x - i
+    for (uint32_t i = 1; i < var_count; i += 2) {
+        cons[i] = add(S, {{(symbol_t)(first + i), 1.0f}, {x, -1.0f}}, relation_e::EQUAL, STRENGTH_REQUIRED, -(num_t)i);
+        REQUIRE(cons[i]);
+    }
+    suggest(S, x, 1000.0f);
+    for (uint32_t i = 0; i < var_count; ++i) {
+        REQUIRE(value(S, (symbol_t)(first + i)) == (i % 2 ? 1000.0f - i : 1000.0f + i));
+    }
+
+    // deleted variables take their rows and x terms with them
+    symbol_t middle[] = {(symbol_t)(first + 100), (symbol_t)(first + 201)};
+    delete_variables(S, 2, middle);
+    suggest(S, x, 500.0f);
+    REQUIRE(value(S, (symbol_t)(first + 99)) == 401.0f);
+    REQUIRE(value(S, (symbol_t)(first + 202)) == 702.0f);
+    REQUIRE(value(S, x) == 500.0f);
+
+    destroy_solver(S);
+}
+
+TEST_CASE("competing preferences", "[cassowary]") {
+    solver_desc_t solver_desc = {};
+    solver_t *S = create_solver(&solver_desc);
+
+    // x == 10 * i (weak), optimum is the weighted median of the preferences
+    symbol_t x = create_variable(S);
+    constraint_handle_t prefs[10] = {};
+    for (uint32_t i = 1; i < 10; ++i) {
+        prefs[i] = add(S, {{x, 1.0f}}, relation_e::EQUAL, STRENGTH_WEAK, 10.0f * i);
+        REQUIRE(prefs[i]);
+    }
+    REQUIRE(value(S, x) == 50.0f);
+
+    // objective multipliers change sign with the strength
+    REQUIRE(set_constraint_strength(S, prefs[8], STRENGTH_MEDIUM) == result_e::OK);
+    REQUIRE(value(S, x) == 80.0f);
+    REQUIRE(set_constraint_strength(S, prefs[8], STRENGTH_WEAK) == result_e::OK);
+    REQUIRE(value(S, x) == 50.0f);
+
+    // objective terms are erased with their error symbols
+    remove_constraint(S, prefs[8]);
+    remove_constraint(S, prefs[1]);
+    REQUIRE(value(S, x) == 50.0f);
+
+    // bound row moves are resolved by the dual ratio test over the objective, x + y <= c, y == 0
+    symbol_t y = create_variable(S);
+    REQUIRE(add(S, {{y, 1.0f}}, relation_e::EQUAL, STRENGTH_REQUIRED, 0.0f));
+    constraint_handle_t bound = add(S, {{x, 1.0f}, {y, 1.0f}}, relation_e::LESSEQUAL, STRENGTH_REQUIRED, 35.0f);
+    REQUIRE(bound);
+    REQUIRE(value(S, x) == 35.0f);
+    REQUIRE(set_constraint_constant(S, bound, 65.0f) == result_e::OK);
+    REQUIRE(value(S, x) == 50.0f);
+    REQUIRE(set_constraint_constant(S, bound, 15.0f) == result_e::OK);
+    REQUIRE(value(S, x) == 15.0f);
+
+    remove_constraint(S, bound);
+    REQUIRE(value(S, x) == 50.0f);
+
+    destroy_solver(S);
+}
+
 // delete_variable
 // delete constraint test
 // inconsistent constraints
\ No newline at end of file
@@ -1,5 +1,8 @@
 #include "catch2/catch.hpp"
 #include "../src/hash_table.inl"
+#include "../src/hash_table_group.inl"
+#include "../src/index_ht.h"
+#include <vector>
 
 struct pos_t {
     uint32_t row, column;
@@ -18,8 +21,9 @@ struct element_data_t {
     double value;
 };
 
+// key-equivalent hash, home slots collide for every 5th column
 static uint32_t hash_uint32_t(const pos_t& pos) {
-    return (pos.column % 5) + 1;
+    return ((pos.column % 5) + 1) | (pos.column << 8) | (pos.row << 20);
 }
 
 static void element_data_move(void* ht_data, uint32_t dst_index, uint32_t src_index) {
@@ -46,9 +50,9 @@ static uint32_t find_pos(const hash_desc_t& ht_desc, const pos_t& pos) {
 
     auto pos_h = hash_uint32_t(pos);
     auto iter = hash_find_index(&ht_desc, pos_h);
-    for (;iter.hash == pos_h; iter = hash_find_next(&ht_desc, &iter)) {
-        if (pos == elems[iter.index].pos)
-            return iter.index;
+    if (iter.hash == pos_h) {
+        REQUIRE(pos == elems[iter.index].pos);
+        return iter.index;
     }
     ht_desc.hashes[iter.index] = pos_h;
     return iter.index;
@@ -116,4 +120,164 @@ TEST_CASE("insert-erase", "[hash_table]") {
         // expect key to be removed
         REQUIRE(elems[index].pos != p);
     }
-}
\ No newline at end of file
+}
+
+static uint32_t find_pos_group(const hash_desc_t& ht_desc, const pos_t& pos) {
+    element_data_t* elems = (element_data_t*)ht_desc.data;
+
+    auto pos_h = hash_uint32_t(pos);
+    auto iter = hash_group_find_index(&ht_desc, pos_h);
+    if (iter.hash == pos_h) {
+        REQUIRE(pos == elems[iter.index].pos);
+        return iter.index;
+    }
+    hash_group_insert((hash_desc_t*)&ht_desc, iter.index, pos_h);
+    return iter.index;
+}
+
+TEST_CASE("group probing insert-erase", "[hash_table]") {
+    uint32_t hashes[16] = {};
+    uint8_t control[16 + HASH_GROUP_WIDTH - 1] = {};
+    element_data_t elems[16] = {};
+
+    hash_desc_t ht_desc = {};
+    ht_desc.hashes = hashes;
+    ht_desc.control = control;
+    ht_desc.data = elems;
+    ht_desc.element_count = 16;
+    hash_group_init(&ht_desc);
+
+    // fill (2, 0..9), every 5th column collides
+    for (uint32_t column = 0; column < 10; ++column) {
+        pos_t p = {2, column};
+        auto index = find_pos_group(ht_desc, p);
+        REQUIRE(elems[index].value == 0.0);
+
+        elems[index].pos = p;
+        elems[index].value = 1.0 + column;
+    }
+
+    // look for (2, 7)
+    {
+        pos_t p = {2, 7};
+        auto index = find_pos_group(ht_desc, p);
+        REQUIRE(elems[index].value == 8.0);
+    }
+
+    // erase (2, 0), expect colliding keys to be shifted back
+    {
+        pos_t p = {2, 0};
+        auto index = find_pos_group(ht_desc, p);
+        REQUIRE(elems[index].value == 1.0);
+
+        hash_group_erase(&s_element_data_impl, &ht_desc, index);
+        REQUIRE(elems[index].pos != p);
+        REQUIRE(control[index] != HASH_CONTROL_EMPTY);
+    }
+
+    for (uint32_t column = 1; column < 10; ++column) {
+        pos_t p = {2, column};
+        auto index = find_pos_group(ht_desc, p);
+        REQUIRE(elems[index].value == 1.0 + column);
+    }
+}
+
+TEMPLATE_TEST_CASE("index_ht insert-find-erase", "[index_ht]", 
+        index_ht::linear_probing_t, index_ht::robin_hood_t, index_ht::group_probing_t) {
+    const uint32_t size = 64;
+    const uint32_t key_count = 24;
+
+    // 4 home slots only, long collision chains
+    auto key_hash = [](uint32_t i) { return ((i % 4) + 1) | (i << 8); };
+
+    std::vector<uint8_t> buffer(index_ht::buffer_size<TestType>(size));
+    index_ht::table_t<TestType> ht = {};
+    index_ht::init(ht, buffer.data(), size);
+
+    for (uint32_t i = 0; i < key_count; ++i) {
+        uint32_t value = 0;
+        auto iter = index_ht::find_index(ht, key_hash(i), &value);
+        REQUIRE(iter.hash != key_hash(i));
+
+        index_ht::insert(ht, iter.index, key_hash(i), i + 100);
+    }
+    REQUIRE(index_ht::count(ht) == key_count);
+    REQUIRE(!index_ht::needs_grow(ht));
+
+    // erase even keys
+    for (uint32_t i = 0; i < key_count; i += 2) {
+        uint32_t value = 0;
+        auto iter = index_ht::find_index(ht, key_hash(i), &value);
+        REQUIRE(iter.hash == key_hash(i));
+        REQUIRE(value == i + 100);
+
+        REQUIRE(index_ht::erase(ht, iter.index) == i + 100);
+    }
+    REQUIRE(index_ht::count(ht) == key_count / 2);
+
+    // grow and migrate by small steps, keys are found in both slot arrays meanwhile
+    std::vector<uint8_t> grown_buffer(index_ht::buffer_size<TestType>(size * 2));
+    index_ht::grow(ht, grown_buffer.data(), size * 2);
+    REQUIRE(index_ht::is_migrating(ht));
+
+    void* drained_buffer = nullptr;
+    for (uint32_t step = 0; !drained_buffer; ++step) {
+        REQUIRE(step < size);
+        drained_buffer = index_ht::migrate(ht, 2);
+
+        for (uint32_t i = 0; i < key_count; ++i) {
+            uint32_t value = 0;
+            auto iter = index_ht::find_index(ht, key_hash(i), &value);
+            bool erased = (i % 2) == 0;
+            REQUIRE((iter.hash == key_hash(i)) == !erased);
+            if (!erased) REQUIRE(value == i + 100);
+        }
+    }
+    REQUIRE(drained_buffer == buffer.data());
+    REQUIRE(!index_ht::is_migrating(ht));
+    REQUIRE(index_ht::count(ht) == key_count / 2);
+}
+
+TEMPLATE_TEST_CASE("index_ht erase while migrating", "[index_ht]", 
+        index_ht::linear_probing_t, index_ht::robin_hood_t, index_ht::group_probing_t) {
+    const uint32_t size = 32;
+    const uint32_t key_count = 16;
+
+    auto key_hash = [](uint32_t i) { return ((i % 3) + 7) | (i << 8); };
+
+    std::vector<uint8_t> buffer(index_ht::buffer_size<TestType>(size));
+    index_ht::table_t<TestType> ht = {};
+    index_ht::init(ht, buffer.data(), size);
+
+    for (uint32_t i = 0; i < key_count; ++i) {
+        uint32_t value = 0;
+        auto iter = index_ht::find_index(ht, key_hash(i), &value);
+        index_ht::insert(ht, iter.index, key_hash(i), i);
+    }
+
+    std::vector<uint8_t> grown_buffer(index_ht::buffer_size<TestType>(size * 2));
+    index_ht::grow(ht, grown_buffer.data(), size * 2);
+
+    // erase and insert keys in both slot arrays, new keys go to grown slots
+    for (uint32_t i = 0; i < key_count; ++i) {
+        index_ht::migrate(ht, 1);
+
+        uint32_t value = 0;
+        auto iter = index_ht::find_index(ht, key_hash(i), &value);
+        REQUIRE(iter.hash == key_hash(i));
+        REQUIRE(value == i);
+        index_ht::erase(ht, iter.index);
+
+        iter = index_ht::find_index(ht, key_hash(i + key_count), &value);
+        REQUIRE(iter.hash != key_hash(i + key_count));
+        index_ht::insert(ht, iter.index, key_hash(i + key_count), i + key_count);
+    }
+    REQUIRE(index_ht::migrate(ht, ~0u) == buffer.data());
+
+    for (uint32_t i = 0; i < key_count * 2; ++i) {
+        uint32_t value = 0;
+        auto iter = index_ht::find_index(ht, key_hash(i), &value);
+        REQUIRE((iter.hash == key_hash(i)) == (i >= key_count));
+    }
+    REQUIRE(index_ht::count(ht) == key_count);
+}